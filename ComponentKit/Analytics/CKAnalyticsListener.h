@@ -108,6 +108,14 @@ struct ComponentTreeDiff;
  */
 - (BOOL)shouldCollectMountInformationForRootComponent:(id<CKMountable>)component;
 
+/**
+ Called before mounting a component tree for which mount information is collected.
+
+ If returns YES, the mount analytics context also carries a trace of timings by view key and component class; see
+ CK::Component::MountTrace. This adds a timestamp read around every traced event, so only enable it when investigating.
+ */
+- (BOOL)shouldCollectMountTraceForRootComponent:(id<CKMountable>)component;
+
 /**
  Called before/after collecting animations from a component tree.
 
@@ -133,6 +141,17 @@ inComponentTreeWithRootComponent:(id<CKMountable>)component
          inScopeRoot:(CKComponentScopeRoot *)scopeRoot
 fromPreviousScopeRoot:(CKComponentScopeRoot *)previousScopeRoot;
 
+/**
+ Called for every memoized CKCompositeComponent during the component tree creation.
+
+ @param componentClass The class of the memoized component.
+ @param reused YES if the child component and tree node subtree of the previous generation were reused, NO if the child was rebuilt.
+ @param scopeRoot Scope root for component tree.
+ */
+- (void)didBuildMemoizedComponent:(Class)componentClass
+            reusedPreviousSubtree:(BOOL)reused
+                      inScopeRoot:(CKComponentScopeRoot *)scopeRoot;
+
 /**
  Provides a systrace listener. Can be nil if systrace is not enabled.
  */
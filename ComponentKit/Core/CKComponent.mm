@@ -19,6 +19,8 @@
 #import <ComponentKit/CKBuildComponent.h>
 #import <ComponentKit/CKComponentScopeEnumeratorProvider.h>
 #import <ComponentKit/CKComponentContextHelper.h>
+#import <ComponentKit/ComponentViewManager.h>
+#import <ComponentKit/ComponentViewReuseUtilities.h>
 #import <ComponentKit/CKFatal.h>
 #import <ComponentKit/CKInternalHelpers.h>
 #import <ComponentKit/CKMacros.h>
@@ -208,7 +210,14 @@ CGSize const kCKComponentParentSizeUndefined = {kCKComponentParentDimensionUndef
     : _viewConfiguration;
 
   CKComponentController *controller = _treeNode.scopeHandle.controller;
-  [controller componentWillMount:self];
+  if (controller) {
+    const auto trace = context.mountAnalyticsContext ? context.mountAnalyticsContext->trace.get() : nullptr;
+    const auto start = trace ? CACurrentMediaTime() : 0;
+    [controller componentWillMount:self];
+    if (trace) {
+      trace->record([self class], CK::Component::MountTrace::willMount, CACurrentMediaTime() - start);
+    }
+  }
 
   const CK::Component::MountContext &effectiveContext = [CKComponentDebugController debugMode]
   ? CKDebugMountContext([self class], context, _viewConfiguration, layout.size) : context;
@@ -470,6 +479,11 @@ static void *kRootComponentMountedViewKey = &kRootComponentMountedViewKey;
   return _treeNode.scopeHandle.controller;
 }
 
+- (BOOL)hasController
+{
+  return _treeNode.scopeHandle.hasController;
+}
+
 - (id<NSObject>)uniqueIdentifier
 {
   return _treeNode ? @(_treeNode.scopeHandle.globalIdentifier) : nil;
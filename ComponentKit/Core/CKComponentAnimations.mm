@@ -10,6 +10,8 @@
 
 #import "CKComponentAnimations.h"
 
+#import <unordered_map>
+
 #import <ComponentKit/CKCasting.h>
 #import <ComponentKit/CKCollection.h>
 #import <ComponentKit/CKInternalHelpers.h>
@@ -25,48 +27,69 @@ namespace CK {
     RCCAssertNotNil(scopeHandle, @"Scope must be provided for component animation");
     return scopeHandle;
   }
-  static auto isSameHandle(CKComponentScopeHandle *const h1, CKComponentScopeHandle *const &h2) { return h1.globalIdentifier == h2.globalIdentifier; };
   static auto acquiredComponent(CKComponentScopeHandle *const h) { return objCForceCast<CKComponent>(h.acquiredComponent); };
 
+  using HandlesByIdentifier = std::unordered_map<CKComponentScopeHandleIdentifier, CKComponentScopeHandle *>;
+
+  /*
+   Indexes the scope handles of the components matching `predicate` by their global identifier, so that the diffs below
+   cost a hash lookup per animated component instead of a scan of the other generation.
+   */
+  static auto handlesMatchingPredicate(const CKComponentRootLayout &layout, const CKMountablePredicate predicate) -> HandlesByIdentifier
+  {
+    const auto components = layout.componentsMatchingPredicate(predicate);
+    auto handles = HandlesByIdentifier {};
+    handles.reserve(components.size());
+    for (const auto &c : components) {
+      const auto h = getScopeHandle(c);
+      // Keep the first handle for an identifier, as a linear search would.
+      handles.emplace(h.globalIdentifier, h);
+    }
+    return handles;
+  }
+
   static auto animatedAppearedComponentsBetweenLayouts(const CKComponentRootLayout &newLayout,
                                                        const CKComponentRootLayout &previousLayout) -> std::vector<CKComponent *>
   {
-    const auto newHandlesWithInitialAnimations = map(newLayout.componentsMatchingPredicate(CKComponentHasAnimationsOnInitialMountPredicate), getScopeHandle);
-    const auto oldHandlesWithInitialAnimations = map(previousLayout.componentsMatchingPredicate(CKComponentHasAnimationsOnInitialMountPredicate), getScopeHandle);
-    const auto handlesForAppearedComponentsWithInitialAnimations = Collection::difference(newHandlesWithInitialAnimations,
-                                                                                          oldHandlesWithInitialAnimations,
-                                                                                          isSameHandle);
-    return map(handlesForAppearedComponentsWithInitialAnimations, acquiredComponent);
+    const auto oldHandlesWithInitialAnimations = handlesMatchingPredicate(previousLayout, CKComponentHasAnimationsOnInitialMountPredicate);
+    auto appearedComponents = std::vector<CKComponent *> {};
+    for (const auto &c : newLayout.componentsMatchingPredicate(CKComponentHasAnimationsOnInitialMountPredicate)) {
+      const auto h = getScopeHandle(c);
+      if (oldHandlesWithInitialAnimations.find(h.globalIdentifier) == oldHandlesWithInitialAnimations.end()) {
+        appearedComponents.push_back(acquiredComponent(h));
+      }
+    }
+    return appearedComponents;
   }
 
   static auto animatedUpdatedComponentsBetweenLayouts(const CKComponentRootLayout &newLayout,
                                                       const CKComponentRootLayout &previousLayout)  -> std::vector<CK::ComponentTreeDiff::Pair>
   {
-    const auto newHandlesWithAnimationsFromPreviousComponent = map(newLayout.componentsMatchingPredicate(CKComponentHasAnimationsFromPreviousComponentPredicate), getScopeHandle);
-    const auto oldHandlesWithAnimationsFromPreviousComponent = map(previousLayout.componentsMatchingPredicate(CKComponentHasAnimationsFromPreviousComponentPredicate), getScopeHandle);
-    const auto handlesForUpdatedComponents = Collection::intersection(newHandlesWithAnimationsFromPreviousComponent,
-                                                                      oldHandlesWithAnimationsFromPreviousComponent,
-                                                                      [](const auto &h1, const auto &h2){
-                                                                        return isSameHandle(h1, h2) && h1.acquiredComponent != h2.acquiredComponent;
-                                                                      });
-
-    return map(handlesForUpdatedComponents, [&](const auto &h){
-      const auto prevHandle =
-      find_if(oldHandlesWithAnimationsFromPreviousComponent,
-              [&](const auto &oldHandle) { return oldHandle.globalIdentifier == h.globalIdentifier; });
-      return ComponentTreeDiff::Pair { acquiredComponent(*prevHandle), acquiredComponent(h) };
-    });
+    const auto oldHandlesWithAnimationsFromPreviousComponent = handlesMatchingPredicate(previousLayout, CKComponentHasAnimationsFromPreviousComponentPredicate);
+    auto updatedComponents = std::vector<CK::ComponentTreeDiff::Pair> {};
+    for (const auto &c : newLayout.componentsMatchingPredicate(CKComponentHasAnimationsFromPreviousComponentPredicate)) {
+      const auto h = getScopeHandle(c);
+      const auto prevHandle = oldHandlesWithAnimationsFromPreviousComponent.find(h.globalIdentifier);
+      // Components reused from the previous generation aren't updated.
+      if (prevHandle != oldHandlesWithAnimationsFromPreviousComponent.end() && prevHandle->second.acquiredComponent != h.acquiredComponent) {
+        updatedComponents.push_back(ComponentTreeDiff::Pair { acquiredComponent(prevHandle->second), acquiredComponent(h) });
+      }
+    }
+    return updatedComponents;
   }
 
   static auto animatedDisappearedComponentsBetweenLayouts(const CKComponentRootLayout &newLayout,
                                                           const CKComponentRootLayout &previousLayout) -> std::vector<CKComponent *>
   {
-    const auto newHandlesWithAnimationsOnDisappear = map(newLayout.componentsMatchingPredicate(CKComponentHasAnimationsOnFinalUnmountPredicate), getScopeHandle);
-    const auto oldHandlesWithAnimationsOnDisappear = map(previousLayout.componentsMatchingPredicate(CKComponentHasAnimationsOnFinalUnmountPredicate), getScopeHandle);
-    const auto handlesForDisappearedComponentsWithAnimationsOnDisappear = Collection::difference(oldHandlesWithAnimationsOnDisappear,
-                                                                                                 newHandlesWithAnimationsOnDisappear,
-                                                                                                 isSameHandle);
-    return map(handlesForDisappearedComponentsWithAnimationsOnDisappear, acquiredComponent);
+    const auto newHandlesWithAnimationsOnDisappear = handlesMatchingPredicate(newLayout, CKComponentHasAnimationsOnFinalUnmountPredicate);
+    auto disappearedComponents = std::vector<CKComponent *> {};
+    for (const auto &c : previousLayout.componentsMatchingPredicate(CKComponentHasAnimationsOnFinalUnmountPredicate)) {
+      const auto h = getScopeHandle(c);
+      if (newHandlesWithAnimationsOnDisappear.find(h.globalIdentifier) == newHandlesWithAnimationsOnDisappear.end()) {
+        disappearedComponents.push_back(acquiredComponent(h));
+      }
+    }
+    return disappearedComponents;
   }
 
   auto animatedComponentsBetweenLayouts(const CKComponentRootLayout &newLayout,
@@ -56,6 +56,13 @@
  @field view The view to attach the component tree to
  @field scopeIdentifier The scope identifier for the component tree, this identifier should be stable among multiple versions
  of the component tree representing the same logical item.
+ @field mountRect Only the parts of the tree whose frames overlap the vertical extent of this rect, in the view's coordinate
+ space, are mounted; mounting is never culled horizontally.
+ Attaching the same layout provider again with a different rect mounts and unmounts incrementally, without animations.
+ @field mountSliceBudget When positive, the tree is mounted over several main run loop turns, spending at most about this
+ many seconds per turn, instead of all at once; see RCMountCursor. Component animations are not applied to such mounts.
+ Attaching or detaching again before the mount is finished abandons it.
+ @field visibleRect When mounting in slices, the parts of the tree overlapping this rect are mounted first.
  */
 struct CKComponentAttachControllerAttachComponentRootLayoutParams {
   const id<CKComponentRootLayoutProvider> layoutProvider;
@@ -63,6 +70,9 @@ struct CKComponentAttachControllerAttachComponentRootLayoutParams {
   const CKComponentBoundsAnimation &boundsAnimation;
   UIView *view;
   id<CKAnalyticsListener> analyticsListener;
+  CGRect mountRect = CGRectInfinite;
+  CFTimeInterval mountSliceBudget = 0;
+  CGRect visibleRect = CGRectInfinite;
 };
 
 void CKComponentAttachControllerAttachComponentRootLayout(
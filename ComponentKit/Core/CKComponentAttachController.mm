@@ -15,6 +15,7 @@
 #import <ComponentKit/RCAssociatedObject.h>
 #import <ComponentKit/CKDelayedNonNull.h>
 #import <ComponentKit/CKOptional.h>
+#import <RenderCore/RCDeferredRelease.h>
 
 #import "CKComponentAnimations.h"
 #import "CKComponentAttachController.h"
@@ -68,6 +69,7 @@ void CKComponentAttachControllerAttachComponentRootLayout(
     RCCAssert(self, @"Impossible to attach a component layout to a nil attachController");
     return;
   }
+  const RCDeferredReleaseTransaction deferredReleaseTransaction;
 
   const auto view = params.view;
   UIView *currentlyAttachedView = self->_scopeIdentifierToAttachedViewMap[@(params.scopeIdentifier)];
@@ -79,13 +81,10 @@ void CKComponentAttachControllerAttachComponentRootLayout(
     [self _detachComponentLayoutFromView:view];
   }
 
-  const auto &prevLayout = [&]() {
-    if (const auto layoutProvider = [self->_scopeIdentifierToLayoutProvider objectForKey:@(params.scopeIdentifier)]) {
-      return layoutProvider.rootLayout;
-    } else {
-      return CKComponentRootLayout {};
-    }
-  }();
+  const auto prevLayoutProvider = [self->_scopeIdentifierToLayoutProvider objectForKey:@(params.scopeIdentifier)];
+  const auto &prevLayout = prevLayoutProvider ? prevLayoutProvider.rootLayout : CKComponentRootLayout {};
+  // Attaching the same layout again, e.g. to mount a different part of it, can't animate anything.
+  const BOOL isRemountingLayout = currentlyAttachedView == view && prevLayoutProvider != nil && prevLayoutProvider == params.layoutProvider;
   // Mount the component tree on the view
   const auto &layout = params.layoutProvider ? params.layoutProvider.rootLayout : CKComponentRootLayout {};
   const auto attachState = mountComponentLayoutInView(layout,
@@ -93,7 +92,11 @@ void CKComponentAttachControllerAttachComponentRootLayout(
                                                       view,
                                                       params.scopeIdentifier,
                                                       params.boundsAnimation,
-                                                      params.analyticsListener);
+                                                      params.analyticsListener,
+                                                      params.mountRect,
+                                                      params.mountSliceBudget,
+                                                      params.visibleRect,
+                                                      !isRemountingLayout);
   // Mark the view as attached and associates it to the right attach state
   self->_scopeIdentifierToAttachedViewMap[@(params.scopeIdentifier)] = view;
   // Save layout provider in map, it will be used for figuring out animations between two layouts.
@@ -111,6 +114,7 @@ void CKComponentAttachControllerAttachComponentRootLayout(
 - (void)detachAll
 {
   RCAssertMainThread();
+  const RCDeferredReleaseTransaction deferredReleaseTransaction;
   for (NSNumber *const scopeIdentifier in _scopeIdentifierToAttachedViewMap.allKeys) {
     [self _detachComponentLayoutWithScopeIdentifier:scopeIdentifier];
   }
@@ -140,10 +144,15 @@ void CKComponentAttachControllerAttachComponentRootLayout(
 {
   CKComponentAttachState *attachState = CKGetAttachStateForView(view);
   if (attachState) {
+    const RCDeferredReleaseTransaction deferredReleaseTransaction;
+    CKComponentAttachStateReleaseMountCursor(attachState);
     CKUnmountComponents(attachState.mountedComponents);
     // Mark the view as detached
     [_scopeIdentifierToAttachedViewMap removeObjectForKey:@(attachState.scopeIdentifier)];
     CKSetAttachStateForView(view, nil);
+    // The attach state holds the root layout and animations, which may retain views, so it stays on the main thread;
+    // it is released in one batch with everything else the enclosing attach or detach drops.
+    RCDeferReleaseOnMainThread(attachState);
   }
 }
 
@@ -152,24 +161,71 @@ static CKComponentAttachState *mountComponentLayoutInView(const CKComponentRootL
                                                           UIView *view,
                                                           CKComponentScopeRootIdentifier scopeIdentifier,
                                                           const CKComponentBoundsAnimation &boundsAnimation,
-                                                          id<CKAnalyticsListener> analyticsListener)
+                                                          id<CKAnalyticsListener> analyticsListener,
+                                                          CGRect mountRect,
+                                                          CFTimeInterval mountSliceBudget,
+                                                          CGRect visibleRect,
+                                                          BOOL collectAnimations)
 {
   RCCAssertNotNil(view, @"Impossible to mount a component layout on a nil view");
-  [analyticsListener willCollectAnimationsFromComponentTreeWithRootComponent:rootLayout.component()];
-  const auto animatedComponents = CK::animatedComponentsBetweenLayouts(rootLayout, prevLayout);
-  const auto animations = CK::animationsForComponents(animatedComponents, view);
-  [analyticsListener didCollectAnimations:animations
-                           fromComponents:animatedComponents
-         inComponentTreeWithRootComponent:rootLayout.component()
-                      scopeRootIdentifier:scopeIdentifier];
-
   auto const oldAttachState = CKGetAttachStateForView(view);
+  // A sliced mount still in progress is abandoned before anything else is mounted in the view; what it mounted so far
+  // counts as previously mounted.
+  if (oldAttachState != nil) {
+    CKComponentAttachStateReleaseMountCursor(oldAttachState);
+  }
   NSSet *currentlyMountedComponents = oldAttachState.mountedComponents;
+  std::shared_ptr<CK::AnimationApplicator<>> animationApplicator;
+  animationApplicator = oldAttachState != nil ? oldAttachState.animationApplicator : CK::AnimationApplicatorFactory::make();
+
+  if (mountSliceBudget > 0) {
+    const auto plan = rootLayout.mountPlan() ? rootLayout.mountPlan() : std::make_shared<const RCMountPlan>(rootLayout.layout());
+    __block __weak CKComponentAttachState *weakAttachState = nil;
+    __block std::shared_ptr<RCMountCursor> mountCursor;
+    CKComponentBoundsAnimationApply(boundsAnimation, ^{
+      mountCursor = CKMountComponentLayoutInSlices(plan,
+                                                   view,
+                                                   currentlyMountedComponents,
+                                                   nil,
+                                                   analyticsListener,
+                                                   mountRect,
+                                                   visibleRect,
+                                                   mountSliceBudget,
+                                                   ^(NSSet<id<CKMountable>> *mountedComponents) {
+                                                     CKComponentAttachState *const attachState = weakAttachState;
+                                                     if (attachState != nil) {
+                                                       CKComponentAttachStateReleaseMountCursor(attachState);
+                                                     }
+                                                   });
+    }, nil);
+    const auto attachState = [[CKComponentAttachState alloc] initWithScopeIdentifier:scopeIdentifier
+                                                                   mountedComponents:CK::makeNonNull(mountCursor->mountedComponents())
+                                                                 animationApplicator:animationApplicator];
+    CKComponentAttachStateSetRootLayout(attachState, rootLayout);
+    CKComponentAttachStateSetMountCursor(attachState, std::move(mountCursor));
+    weakAttachState = attachState;
+    return attachState;
+  }
+
+  CKComponentAnimations animations;
+  if (collectAnimations) {
+    [analyticsListener willCollectAnimationsFromComponentTreeWithRootComponent:rootLayout.component()];
+    const auto animatedComponents = CK::animatedComponentsBetweenLayouts(rootLayout, prevLayout);
+    animations = CK::animationsForComponents(animatedComponents, view);
+    [analyticsListener didCollectAnimations:animations
+                             fromComponents:animatedComponents
+           inComponentTreeWithRootComponent:rootLayout.component()
+                        scopeRootIdentifier:scopeIdentifier];
+  }
+
   __block NSSet *newMountedComponents = nil;
   const auto mountPerformer = ^{
     __block NSMutableSet<CKComponent *> *unmountedComponents;
     CKComponentBoundsAnimationApply(boundsAnimation, ^{
-      newMountedComponents = CKMountComponentLayout(rootLayout.layout(), view, currentlyMountedComponents, nil, analyticsListener);
+      newMountedComponents =
+      rootLayout.mountPlan()
+      ? CKMountComponentLayout(*rootLayout.mountPlan(), view, currentlyMountedComponents, nil, analyticsListener, mountRect)
+      : CKMountComponentLayout(RCMountPlan(rootLayout.layout()), view, currentlyMountedComponents, nil, analyticsListener, mountRect);
 
       // This could probably be done more efficiently by making mountPerformer
       // return a pair: currentlyMountedComponents & newMountedComponents.
@@ -180,8 +236,6 @@ static CKComponentAttachState *mountComponentLayoutInView(const CKComponentRootL
     return unmountedComponents;
   };
 
-  std::shared_ptr<CK::AnimationApplicator<>> animationApplicator;
-  animationApplicator = oldAttachState != nil ? oldAttachState.animationApplicator : CK::AnimationApplicatorFactory::make();
   animationApplicator->runAnimationsWhenMounting(animations, mountPerformer);
 
   const auto attachState = [[CKComponentAttachState alloc] initWithScopeIdentifier:scopeIdentifier
@@ -196,6 +250,7 @@ static void tearDownAttachStateFromViews(NSArray<UIView *> *views)
   for (UIView *view in views) {
     CKComponentAttachState *attachState = CKGetAttachStateForView(view);
     if (attachState) {
+      CKComponentAttachStateReleaseMountCursor(attachState);
       CKUnmountComponents(attachState.mountedComponents);
       CKSetAttachStateForView(view, nil);
     }
@@ -211,6 +266,7 @@ static void tearDownAttachStateFromViews(NSArray<UIView *> *views)
   // The ownership isn't really shared with anyone, this is just to get copying the pointer in and out of the attach state easier
   std::shared_ptr<CK::AnimationApplicator<>> _animationApplicator;
   CK::DelayedNonNull<NSSet *> _mountedComponents;
+  std::shared_ptr<RCMountCursor> _mountCursor;
 }
 
 - (instancetype)initWithScopeIdentifier:(CKComponentScopeRootIdentifier)scopeIdentifier
@@ -236,6 +292,23 @@ void CKComponentAttachStateSetRootLayout(CKComponentAttachState *const self, con
   self->_rootLayout = rootLayout;
 }
 
+void CKComponentAttachStateSetMountCursor(CKComponentAttachState *const self, std::shared_ptr<RCMountCursor> mountCursor)
+{
+  if (mountCursor && mountCursor->isFinished()) {
+    self->_mountedComponents = CK::makeNonNull(mountCursor->mountedComponents());
+    return;
+  }
+  self->_mountCursor = std::move(mountCursor);
+}
+
+void CKComponentAttachStateReleaseMountCursor(CKComponentAttachState *const self)
+{
+  if (self->_mountCursor) {
+    self->_mountedComponents = CK::makeNonNull(self->_mountCursor->mountedComponents());
+    self->_mountCursor = nullptr;
+  }
+}
+
 - (const std::shared_ptr<CK::AnimationApplicator<>> &)animationApplicator
 {
   return _animationApplicator;
@@ -243,7 +316,7 @@ void CKComponentAttachStateSetRootLayout(CKComponentAttachState *const self, con
 
 - (CK::NonNull<NSSet *>)mountedComponents
 {
-  return _mountedComponents;
+  return _mountCursor ? CK::makeNonNull(_mountCursor->mountedComponents()) : _mountedComponents;
 }
 
 @end
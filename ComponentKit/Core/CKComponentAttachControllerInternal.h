@@ -37,6 +37,13 @@
 
 const CKComponentRootLayout &CKComponentAttachStateRootLayout(const CKComponentAttachState *const self);
 void CKComponentAttachStateSetRootLayout(CKComponentAttachState *const self, const CKComponentRootLayout &rootLayout);
+/**
+ Keeps the cursor of a sliced mount alive, and its mountedComponents() as the attach state's, until it is released. A
+ finished cursor isn't kept.
+ */
+void CKComponentAttachStateSetMountCursor(CKComponentAttachState *const self, std::shared_ptr<RCMountCursor> mountCursor);
+/** Stops a sliced mount, if any, keeping the components it mounted so far as the attach state's mounted components. */
+void CKComponentAttachStateReleaseMountCursor(CKComponentAttachState *const self);
 
 @interface CKComponentAttachController ()
 
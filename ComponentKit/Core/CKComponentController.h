@@ -89,6 +89,16 @@
  */
 - (void)didPrepareLayout:(const RCLayout &)layout forComponent:(CKComponent *)component;
 
+/**
+ Return YES to defer building the controller until it is first needed: when its component mounts, when an action reaches
+ it through the responder chain or when it is accessed via -[CKComponent controller]. Components that are never mounted
+ (e.g. off-screen items of a long list) then never pay for their controller. Defaults to NO.
+
+ Ignored for controllers overriding -didInit, -componentTreeWillAppear, -componentTreeDidDisappear,
+ -invalidateController or -didPrepareLayout:forComponent:, as those are delivered whether or not the component mounts.
+ */
++ (BOOL)shouldBeCreatedLazily;
+
 /** The current version of the component. */
 @property (nonatomic, weak, readonly) ComponentType component;
 
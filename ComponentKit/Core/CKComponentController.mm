@@ -142,6 +142,11 @@ static NSString *componentStateName(CKComponentControllerState state)
   return NO;
 }
 
++ (BOOL)shouldBeCreatedLazily
+{
+  return NO;
+}
+
 - (void)didInit {
   RCAssertMainThread();
 #if CK_ASSERTIONS_ENABLED
@@ -13,6 +13,7 @@
 #import <ComponentKit/CKInternalHelpers.h>
 
 #import "CKComponentInternal.h"
+#import "CKComponentScopeHandle.h"
 #import "CKComponentControllerInternal.h"
 #import "CKComponentSubclass.h"
 #import "CKComponentProtocol.h"
@@ -92,7 +93,9 @@ void CKComponentUpdateComponentForComponentControllerWithIndexPaths(id<NSFastEnu
     CKDataSourceItem *item = [state objectAtIndexPath:indexPath];
     item.rootLayout.enumerateCachedLayout(^(const RCLayout &layout) {
       const auto component = (CKComponent *)layout.component;
-      component.controller.latestComponent = component;
+      // Lazily created controllers that aren't built yet are built with the component that first needs them.
+      const auto controller = (CKComponentController *)component.treeNode.scopeHandle.builtController;
+      controller.latestComponent = component;
     });
   }
 }
@@ -99,6 +99,9 @@
 /** For internal use; don't touch this. */
 @property (nonatomic, assign, readonly) BOOL controllerOverridesDidPrepareLayout;
 
+/** For internal use; don't touch this. Unlike -controller, doesn't build a lazily created controller. */
+@property (nonatomic, assign, readonly) BOOL hasController;
+
 @end
 
 #endif
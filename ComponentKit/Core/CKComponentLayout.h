@@ -61,6 +61,35 @@ NSSet<id<CKMountable>> *CKMountComponentLayout(const RCLayout &layout,
                                                id<CKMountable> supercomponent,
                                                id<CKAnalyticsListener> analyticsListener = nil);
 
+/**
+ Mounts a precomputed plan; behaves like the variant above on the plan's layout.
+ @param mountRect Only subtrees whose frame intersects this rect are mounted; see CKMountLayout.
+ */
+NSSet<id<CKMountable>> *CKMountComponentLayout(const RCMountPlan &plan,
+                                               UIView *view,
+                                               NSSet<id<CKMountable>> *previouslyMountedComponents,
+                                               id<CKMountable> supercomponent,
+                                               id<CKAnalyticsListener> analyticsListener = nil,
+                                               CGRect mountRect = CGRectInfinite);
+
+/**
+ Mounts a plan like CKMountComponentLayout, but over several main run loop turns; see RCMountCursor and
+ CKMountLayoutInSlices. The analytics listener is told the tree is mounted once the last slice is, when the completion is
+ called, or when the cursor is released if that happens first.
+ @param visibleRect Subtrees overlapping this rect are mounted first.
+ @return The cursor doing the mount, which stops if it is released. Its mountedComponents() are what to unmount, or to
+         pass as previously mounted components, if something else is mounted in the view before it finishes.
+ */
+std::shared_ptr<RCMountCursor> CKMountComponentLayoutInSlices(std::shared_ptr<const RCMountPlan> plan,
+                                                              UIView *view,
+                                                              NSSet<id<CKMountable>> *previouslyMountedComponents,
+                                                              id<CKMountable> supercomponent,
+                                                              id<CKAnalyticsListener> analyticsListener,
+                                                              CGRect mountRect,
+                                                              CGRect visibleRect,
+                                                              CFTimeInterval budgetPerSlice,
+                                                              void (^completion)(NSSet<id<CKMountable>> *mountedComponents));
+
 struct CKComponentRootLayout { // This is pending renaming
   /** Layout cache for components that have controller. */
   using ComponentLayoutCache = std::unordered_map<id<CKMountable>, RCLayout, RC::hash<id<CKMountable>>, RC::is_equal<id<CKMountable>>>;
@@ -71,6 +100,8 @@ struct CKComponentRootLayout { // This is pending renaming
   : CKComponentRootLayout({layout, nil}, {}, {}) {}
   explicit CKComponentRootLayout(RCLayoutResult layoutResult, ComponentLayoutCache layoutCache, ComponentsByPredicateMap componentsByPredicate)
   : _layoutResult(std::move(layoutResult)), _layoutCache(std::move(layoutCache)), _componentsByPredicate(std::move(componentsByPredicate)) {}
+  explicit CKComponentRootLayout(RCLayoutResult layoutResult, ComponentLayoutCache layoutCache, ComponentsByPredicateMap componentsByPredicate, std::shared_ptr<const RCMountPlan> mountPlan)
+  : _layoutResult(std::move(layoutResult)), _layoutCache(std::move(layoutCache)), _componentsByPredicate(std::move(componentsByPredicate)), _mountPlan(std::move(mountPlan)) {}
 
   /**
    This method returns a RCLayout from the cache for the component if it has a controller.
@@ -94,11 +125,14 @@ struct CKComponentRootLayout { // This is pending renaming
   const auto &cache() const { return _layoutResult.cache; }
   auto component() const { return _layoutResult.layout.component; }
   auto size() const { return _layoutResult.layout.size; }
+  /** The plan for mounting `layout()`, if it was computed along with the layout; may be null. */
+  const auto &mountPlan() const { return _mountPlan; }
 
 private:
   RCLayoutResult _layoutResult;
   ComponentLayoutCache _layoutCache;
   ComponentsByPredicateMap _componentsByPredicate;
+  std::shared_ptr<const RCMountPlan> _mountPlan;
 };
 
 /**
@@ -109,6 +143,8 @@ private:
  @param buildTrigger Indicates the source that triggers this layout computation.
  @param scopeRoot The scope root of the current tree.
  @param layoutCache An optional layout cache for the current tree.
+ @param previousRootLayout If the previous generation of the tree may be mounted where this one will be, pass its
+        layout so that attribute diffs for the views it used can be prepared along with the layout.
 
  */
 CKComponentRootLayout CKComputeRootComponentLayout(id<CKMountable> rootComponent,
@@ -116,7 +152,8 @@ CKComponentRootLayout CKComputeRootComponentLayout(id<CKMountable> rootComponent
                                                    id<CKAnalyticsListener> analyticsListener = nil,
                                                    CK::Optional<CKBuildTrigger> buildTrigger = CK::none,
                                                    CKComponentScopeRoot *scopeRoot = nil,
-                                                   std::shared_ptr<RCLayoutCache> layoutCache = nullptr);
+                                                   std::shared_ptr<RCLayoutCache> layoutCache = nullptr,
+                                                   const CKComponentRootLayout *previousRootLayout = nullptr);
 
 /**
  Safely computes the layout of the given component by guarding against nil components.
@@ -18,6 +18,7 @@
 #import <ComponentKit/ComponentLayoutContext.h>
 #import <ComponentKit/CKComponentScopeRoot.h>
 
+#import <algorithm>
 #import <pthread.h>
 
 NSSet<id<CKMountable>> *CKMountComponentLayout(const RCLayout &layout,
@@ -26,20 +27,35 @@ NSSet<id<CKMountable>> *CKMountComponentLayout(const RCLayout &layout,
                                                id<CKMountable> supercomponent,
                                                id<CKAnalyticsListener> analyticsListener)
 {
+  return CKMountComponentLayout(RCMountPlan(layout), view, previouslyMountedComponents, supercomponent, analyticsListener);
+}
+
+NSSet<id<CKMountable>> *CKMountComponentLayout(const RCMountPlan &plan,
+                                               UIView *view,
+                                               NSSet<id<CKMountable>> *previouslyMountedComponents,
+                                               id<CKMountable> supercomponent,
+                                               id<CKAnalyticsListener> analyticsListener,
+                                               CGRect mountRect)
+{
+  const auto &layout = plan.layout();
   ((CKComponent *)layout.component).rootComponentMountedView = view;
   [analyticsListener willMountComponentTreeWithRootComponent:layout.component];
 
   CK::Component::MountAnalyticsContext mountAnalyticsContext;
   const BOOL collectMountAnalytics =
   [analyticsListener shouldCollectMountInformationForRootComponent:layout.component];
+  if (collectMountAnalytics && [analyticsListener shouldCollectMountTraceForRootComponent:layout.component]) {
+    mountAnalyticsContext.trace = std::make_shared<CK::Component::MountTrace>();
+  }
 
   NSSet<id<CKMountable>> *const mountedComponents =
-  CKMountLayout(layout,
+  CKMountLayout(plan,
                 view,
                 previouslyMountedComponents,
                 supercomponent,
                 collectMountAnalytics ? &mountAnalyticsContext : nullptr,
-                analyticsListener.systraceListener);
+                analyticsListener.systraceListener,
+                mountRect);
   [analyticsListener
    didMountComponentTreeWithRootComponent:layout.component
    mountAnalyticsContext:
@@ -49,6 +65,59 @@ NSSet<id<CKMountable>> *CKMountComponentLayout(const RCLayout &layout,
   return mountedComponents;
 }
 
+namespace {
+  /** A sliced mount, which ends the listener's mount of the tree even if the cursor is released before it finishes. */
+  struct SlicedMount {
+    RCMountCursor cursor;
+    id<CKAnalyticsListener> analyticsListener;
+    id<CKMountable> rootComponent;
+
+    ~SlicedMount()
+    {
+      if (!cursor.isFinished()) {
+        [analyticsListener didMountComponentTreeWithRootComponent:rootComponent mountAnalyticsContext:CK::none];
+      }
+    }
+  };
+}
+
+std::shared_ptr<RCMountCursor> CKMountComponentLayoutInSlices(std::shared_ptr<const RCMountPlan> plan,
+                                                              UIView *view,
+                                                              NSSet<id<CKMountable>> *previouslyMountedComponents,
+                                                              id<CKMountable> supercomponent,
+                                                              id<CKAnalyticsListener> analyticsListener,
+                                                              CGRect mountRect,
+                                                              CGRect visibleRect,
+                                                              CFTimeInterval budgetPerSlice,
+                                                              void (^completion)(NSSet<id<CKMountable>> *mountedComponents))
+{
+  id<CKMountable> const rootComponent = plan->layout().component;
+  ((CKComponent *)rootComponent).rootComponentMountedView = view;
+  [analyticsListener willMountComponentTreeWithRootComponent:rootComponent];
+
+  // Mount analytics aren't collected: their context would have to outlive this call.
+  const std::shared_ptr<SlicedMount> slicedMount(new SlicedMount {
+    RCMountCursor(std::move(plan),
+                  view,
+                  previouslyMountedComponents,
+                  supercomponent,
+                  visibleRect,
+                  nullptr,
+                  analyticsListener.systraceListener,
+                  mountRect),
+    analyticsListener,
+    rootComponent,
+  });
+  const std::shared_ptr<RCMountCursor> cursor(slicedMount, &slicedMount->cursor);
+  CKMountLayoutInSlices(cursor, budgetPerSlice, nullptr, ^(NSSet<id<CKMountable>> *mountedComponents) {
+    [analyticsListener didMountComponentTreeWithRootComponent:rootComponent mountAnalyticsContext:CK::none];
+    if (completion) {
+      completion(mountedComponents);
+    }
+  });
+  return cursor;
+}
+
 static auto buildComponentsByPredicateMap(const RCLayout &layout,
                                           const std::unordered_set<CKMountablePredicate> &predicates)
 {
@@ -67,12 +136,47 @@ static auto buildComponentsByPredicateMap(const RCLayout &layout,
   return componentsByPredicate;
 }
 
+/**
+ Pairs the components of two generations of a tree by position and prepares attribute diffs between their views: in
+ steady state, a view is reused for the component in the same place in the next generation. A wrong pairing only costs
+ the diff, since prepared diffs are verified against the view's attributes during mount.
+ */
+static std::shared_ptr<const CK::Component::MountPreparation> prepareMount(const RCLayout &layout,
+                                                                           const RCLayout &previousLayout)
+{
+  auto preparation = std::make_shared<CK::Component::MountPreparation>();
+  std::vector<std::pair<const RCLayout *, const RCLayout *>> stack {{&layout, &previousLayout}};
+  while (!stack.empty()) {
+    const auto pair = stack.back();
+    stack.pop_back();
+    const auto component = (CKComponent *)pair.first->component;
+    const auto previousComponent = (CKComponent *)pair.second->component;
+    if (component == previousComponent ||
+        ![component isKindOfClass:[CKComponent class]] ||
+        [previousComponent class] != [component class]) {
+      continue; // Reused subtrees are already mounted; other mismatches mean the trees diverge here.
+    }
+    const auto &viewConfiguration = [component viewConfiguration];
+    const auto &previousViewConfiguration = [previousComponent viewConfiguration];
+    if (viewConfiguration.viewClass().hasView() &&
+        viewConfiguration.viewClass() == previousViewConfiguration.viewClass()) {
+      preparation->prepare(previousViewConfiguration, viewConfiguration);
+    }
+    const auto childCount = std::min(pair.first->children->size(), pair.second->children->size());
+    for (size_t i = 0; i < childCount; i++) {
+      stack.push_back({&(*pair.first->children)[i].layout, &(*pair.second->children)[i].layout});
+    }
+  }
+  return preparation->empty() ? nullptr : preparation;
+}
+
 CKComponentRootLayout CKComputeRootComponentLayout(id<CKMountable> rootComponent,
                                                    const CKSizeRange &sizeRange,
                                                    id<CKAnalyticsListener> analyticsListener,
                                                    CK::Optional<CKBuildTrigger> buildTrigger,
                                                    CKComponentScopeRoot *scopeRoot,
-                                                   std::shared_ptr<RCLayoutCache> layoutCache)
+                                                   std::shared_ptr<RCLayoutCache> layoutCache,
+                                                   const CKComponentRootLayout *previousRootLayout)
 {
   [analyticsListener willLayoutComponentTreeWithRootComponent:rootComponent buildTrigger:buildTrigger];
   CK::Component::LayoutSystraceContext systraceContext([analyticsListener systraceListener]);
@@ -86,15 +190,21 @@ CKComponentRootLayout CKComputeRootComponentLayout(id<CKMountable> rootComponent
 
   auto layoutLookup = CKComponentRootLayout::ComponentLayoutCache {};
   layoutResult.layout.enumerateLayouts([&](const auto &l){
-    if ([l.component isKindOfClass:[CKComponent class]] && ((CKComponent *)l.component).controller) {
+    if ([l.component isKindOfClass:[CKComponent class]] && ((CKComponent *)l.component).hasController) {
       layoutLookup[l.component] = l;
     }
   });
   const auto componentsByPredicate = buildComponentsByPredicateMap(layoutResult.layout, CKComponentAnimationPredicates());
+  // Flattening the layout and diffing view attributes for mount here keeps that work off the main thread.
+  auto mountPlan = std::make_shared<const RCMountPlan>(layoutResult.layout,
+                                                       previousRootLayout
+                                                       ? prepareMount(layoutResult.layout, previousRootLayout->layout())
+                                                       : nullptr);
   const auto rootLayout = CKComponentRootLayout {
     layoutResult,
     layoutLookup,
     componentsByPredicate,
+    std::move(mountPlan),
   };
 
   CKDetectDuplicateComponent(rootLayout.layout());
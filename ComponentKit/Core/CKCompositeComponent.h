@@ -56,6 +56,31 @@ CK_COMPONENT_INIT_UNAVAILABLE;
  */
 + (nullable instancetype)newWithView:(const CKComponentViewConfiguration &)view component:(NS_RELEASES_ARGUMENT id<CKMountable> _Nullable)component;
 
+/**
+ Opt-in memoization of the child subtree.
+
+ When the previous generation of this component was built from props equal to `props` (see `+arePropsEqual:toPreviousProps:`),
+ its child component and tree node subtree are reused and `childProvider` is not invoked. Otherwise the child is built by calling
+ `childProvider`. This mirrors `shouldComponentUpdate:` reuse of render components for classic component trees.
+
+ Must be called after the component's `CKComponentScope` has been created. `props` should capture every input of
+ `childProvider`, including any component context it reads. No reuse happens on environment updates, when a state update
+ targets the component or any component below it, or when the tree contains render components.
+
+ @param view Passed to CKComponent's initializer.
+ @param props The inputs the child is built from; compared with the props of the previous generation.
+ @param childProvider Builds the child component; only called when the previous child can't be reused.
+ */
++ (nullable instancetype)newWithView:(const CKComponentViewConfiguration &)view
+                               props:(id _Nullable)props
+                       childProvider:(NS_NOESCAPE id<CKMountable> _Nullable (^)(void))childProvider;
+
+/**
+ Props-equality function used by memoized composite components. Returns YES if the child built from `previousProps` can be
+ reused for `props`. Defaults to `RCObjectIsEqual`; override to compare only the relevant parts of the props.
+ */
++ (BOOL)arePropsEqual:(id _Nullable)props toPreviousProps:(id _Nullable)previousProps;
+
 #endif
 
 /** Access the child component. For internal use only. */
@@ -72,7 +97,8 @@ CK_COMPONENT_INIT_UNAVAILABLE;
   - (instancetype _Nullable)initWithView:(const CKComponentViewConfiguration &)view \
                                component:(NS_RELEASES_ARGUMENT id<CKMountable> _Nullable)component NS_UNAVAILABLE; \
   + (instancetype _Nullable)newWithComponent:(NS_RELEASES_ARGUMENT id<CKMountable> _Nullable)component NS_UNAVAILABLE; \
-  + (instancetype _Nullable)newWithView:(const CKComponentViewConfiguration &)view component:(NS_RELEASES_ARGUMENT id<CKMountable> _Nullable)component NS_UNAVAILABLE;
+  + (instancetype _Nullable)newWithView:(const CKComponentViewConfiguration &)view component:(NS_RELEASES_ARGUMENT id<CKMountable> _Nullable)component NS_UNAVAILABLE; \
+  + (instancetype _Nullable)newWithView:(const CKComponentViewConfiguration &)view props:(id _Nullable)props childProvider:(NS_NOESCAPE id<CKMountable> _Nullable (^)(void))childProvider NS_UNAVAILABLE;
 #endif
 
 NS_ASSUME_NONNULL_END
@@ -11,18 +11,25 @@
 #import "CKCompositeComponent.h"
 
 #import <RenderCore/RCAssert.h>
+#import <ComponentKit/CKAnalyticsListener.h>
+#import <ComponentKit/CKGlobalConfig.h>
 #import <ComponentKit/CKMacros.h>
 #import <ComponentKit/CKInternalHelpers.h>
 
 #import "CKComponentInternal.h"
+#import "CKComponentScopeRoot.h"
 #import "CKComponentSubclass.h"
 #import "CKIterableHelpers.h"
 #import "CKRenderHelpers.h"
+#import "CKThreadLocalComponentScope.h"
+#import "CKTreeNode.h"
 #import "CKComponentViewConfiguration_SwiftBridge+Internal.h"
 
 @implementation CKCompositeComponent
 {
   id<CKMountable> _child;
+  id _props;
+  BOOL _memoized;
 }
 
 #if DEBUG
@@ -80,6 +87,59 @@
   return c;
 }
 
++ (instancetype)newWithView:(const CKComponentViewConfiguration &)view
+                      props:(id)props
+              childProvider:(NS_NOESCAPE id<CKMountable> (^)(void))childProvider
+{
+  RCAssertNotNil(childProvider, @"Must have a child provider");
+
+  id<CKMountable> child = nil;
+  CKThreadLocalComponentScope *const threadLocalScope = CKThreadLocalComponentScope::currentScope();
+  if (threadLocalScope != nullptr) {
+    // Copied, as building the child pushes frames onto the scope stack.
+    const CKComponentScopePair pair = threadLocalScope->stack.top();
+    RCAssertWithCategory(pair.node.scopeHandle.componentTypeName == class_getName(self) && pair.node.scopeHandle.acquiredComponent == nil,
+                         NSStringFromClass(self),
+                         @"Memoized composite components must create their CKComponentScope before calling newWithView:props:childProvider:");
+
+    auto const previousComponent = (CKCompositeComponent *)pair.previousNode.scopeHandle.acquiredComponent;
+    const BOOL canReuse =
+      previousComponent != nil &&
+      [previousComponent class] == self &&
+      previousComponent->_memoized &&
+      (threadLocalScope->buildTrigger & CKBuildTriggerEnvironmentUpdate) == 0 &&
+      // Memoized subtrees are only tracked through scope links; reusing them would skip linking render nodes.
+      [threadLocalScope->previousScopeRoot hasRenderComponentInTree] == NO &&
+      CKReadGlobalConfig().alwaysBuildRenderTree == NO &&
+      [self arePropsEqual:props toPreviousProps:previousComponent->_props] &&
+      [pair.previousNode hasStateUpdateInOwnedSubtree:threadLocalScope->stateUpdates] == NO;
+
+    if (canReuse) {
+      child = previousComponent->_child;
+      [pair.node reuseOwnedSubtreeOfPreviousNode:pair.previousNode inScopeRoot:threadLocalScope->newScopeRoot];
+    } else {
+      child = childProvider();
+    }
+
+    CKComponentScopeRoot *const scopeRoot = threadLocalScope->newScopeRoot;
+    [scopeRoot.analyticsListener didBuildMemoizedComponent:self reusedPreviousSubtree:canReuse inScopeRoot:scopeRoot];
+  } else {
+    child = childProvider();
+  }
+
+  CKCompositeComponent *const c = [self newWithView:view component:child];
+  if (c != nil) {
+    c->_props = props;
+    c->_memoized = YES;
+  }
+  return c;
+}
+
++ (BOOL)arePropsEqual:(id)props toPreviousProps:(id)previousProps
+{
+  return RCObjectIsEqual(props, previousProps);
+}
+
 - (RCLayout)computeLayoutThatFits:(CKSizeRange)constrainedSize
                           restrictedToSize:(const RCComponentSize &)size
                       relativeToParentSize:(CGSize)parentSize
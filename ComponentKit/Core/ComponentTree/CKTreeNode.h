@@ -96,6 +96,15 @@ struct CKComponentScopePair {
 
 - (void)reusePreviousNode:(CKTreeNode *)node inScopeRoot:(CKComponentScopeRoot *)scopeRoot;
 
+/**
+ Adopts the children of a previous generation's node and registers the components and controllers of its owned (scope created)
+ subtree in the new scope root. Used by memoized composite components, whose subtree is never linked as parent nodes.
+ */
+- (void)reuseOwnedSubtreeOfPreviousNode:(CKTreeNode *)node inScopeRoot:(CKComponentScopeRoot *)scopeRoot;
+
+/** Returns YES if this node or any node in its owned (scope created) subtree has a pending state update. */
+- (BOOL)hasStateUpdateInOwnedSubtree:(const CKComponentStateUpdateMap &)stateUpdates;
+
 /** This method should be called after a node has been reused */
 - (void)didReuseWithParent:(CKTreeNode *)parent
                inScopeRoot:(CKComponentScopeRoot *)scopeRoot;
@@ -175,6 +175,46 @@ namespace TreeNode {
   }
 }
 
+- (void)reuseOwnedSubtreeOfPreviousNode:(CKTreeNode *)node inScopeRoot:(CKComponentScopeRoot *)scopeRoot
+{
+  // Transfer the children vector from the reused node.
+  _children = node->_children;
+
+  for (auto const &child : _children) {
+    if (child.key.type() == CKTreeNodeComponentKey::Type::owner) {
+      [child.node didReuseOwnedSubtreeInScopeRoot:scopeRoot];
+    }
+  }
+}
+
+- (void)didReuseOwnedSubtreeInScopeRoot:(CKComponentScopeRoot *)scopeRoot
+{
+  // Register the reused component and its controller in the new scope root.
+  [_scopeHandle registerInScopeRoot:scopeRoot];
+
+  for (auto const &child : _children) {
+    if (child.key.type() == CKTreeNodeComponentKey::Type::owner) {
+      [child.node didReuseOwnedSubtreeInScopeRoot:scopeRoot];
+    }
+  }
+}
+
+- (BOOL)hasStateUpdateInOwnedSubtree:(const CKComponentStateUpdateMap &)stateUpdates
+{
+  if (stateUpdates.empty()) {
+    return NO;
+  }
+  if (_scopeHandle != nil && stateUpdates.find(_scopeHandle) != stateUpdates.end()) {
+    return YES;
+  }
+  for (auto const &child : _children) {
+    if (child.key.type() == CKTreeNodeComponentKey::Type::owner && [child.node hasStateUpdateInOwnedSubtree:stateUpdates]) {
+      return YES;
+    }
+  }
+  return NO;
+}
+
 
 - (void)didReuseWithParent:(CKTreeNode *)parent
                inScopeRoot:(CKComponentScopeRoot *)scopeRoot
@@ -187,15 +227,9 @@ namespace TreeNode {
 
   RCAssert(parent != nil, @"The parent cannot be nil; every node should have a valid parent.");
   scopeRoot.rootNode.registerNode(self, parent);
-  if (_scopeHandle) {
-    // Register the reused comopnent in the new scope root.
-    [scopeRoot registerComponent:_component];
-    auto const controller = _scopeHandle.controller;
-    if (controller) {
-      // Register the controller in the new scope root.
-      [scopeRoot registerComponentController:controller];
-    }
-  }
+  // Register the reused component and its controller in the new scope root; the handle replays the predicates they
+  // matched in the previous one.
+  [_scopeHandle registerInScopeRoot:scopeRoot];
 
   for (auto const &child : _children) {
     if (child.key.type() == CKTreeNodeComponentKey::Type::parent) {
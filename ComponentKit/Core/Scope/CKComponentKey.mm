@@ -16,15 +16,15 @@ CKComponentKey::CKComponentKey(id<NSObject> key) noexcept
 : _threadLocalScope(CKThreadLocalComponentScope::currentScope()), _key(key)
 {
   if (_threadLocalScope && _key) {
-    _threadLocalScope->keys.top().push_back(key);
+    _threadLocalScope->stack.keys().push_back(key);
   }
 }
 
 CKComponentKey::~CKComponentKey() noexcept
 {
   if (_threadLocalScope && _key) {
-    RCCAssert(_threadLocalScope->keys.top().back() == _key, @"Key mismatch: %@ vs %@",
-              _threadLocalScope->keys.top().back(), _key);
-    _threadLocalScope->keys.top().pop_back();
+    RCCAssert(_threadLocalScope->stack.keys().back() == _key, @"Key mismatch: %@ vs %@",
+              _threadLocalScope->stack.keys().back(), _key);
+    _threadLocalScope->stack.keys().pop_back();
   }
 }
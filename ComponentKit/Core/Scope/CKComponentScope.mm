@@ -77,7 +77,7 @@ CKComponentScope::CKComponentScope(Class __unsafe_unretained componentClass, id
                                                 newRoot:_threadLocalScope->newScopeRoot
                                       componentTypeName:componentTypeName
                                              identifier:identifier
-                                                   keys:_threadLocalScope->keys.top()
+                                                   keys:_threadLocalScope->stack.keys()
                                          initialStateCreator:toInitialStateCreator(initialStateCreator, componentClass)
                                                 stateUpdates:_threadLocalScope->stateUpdates
                                          requiresScopeHandle:YES];
@@ -86,7 +86,7 @@ CKComponentScope::CKComponentScope(Class __unsafe_unretained componentClass, id
     const auto ancestorHasStateUpdate =
         _threadLocalScope->coalescingMode == RCComponentCoalescingModeComposite &&
          _threadLocalScope->buildTrigger == CKBuildTriggerStateUpdate &&
-        (_threadLocalScope->ancestorHasStateUpdate.top() ||
+        (_threadLocalScope->stack.ancestorHasStateUpdate() ||
            CKRender::componentHasStateUpdate(
                _node,
                pair.previousNode,
@@ -70,10 +70,16 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  Should not be called until after nodeForComponent(). The controller will assert (if assertions are compiled), and
- return nil until `resolve` is called.
+ return nil until `resolve` is called. Controllers that are created lazily are built on first access.
  */
 @property (nonatomic, strong, readonly, nullable) id<CKComponentControllerProtocol> controller;
 
+/** The controller if it was built already. Unlike -controller, never builds a lazily created controller. */
+@property (nonatomic, strong, readonly, nullable) id<CKComponentControllerProtocol> builtController;
+
+/** Whether the handle has a controller, either built or pending lazy creation. Never builds the controller. */
+@property (nonatomic, assign, readonly) BOOL hasController;
+
 @property (nonatomic, assign, readonly) const char* componentTypeName;
 
 @property (nonatomic, strong, readonly, nullable) id state;
@@ -102,6 +108,33 @@ NS_ASSUME_NONNULL_BEGIN
 
 #if CK_NOT_SWIFT
 
+/**
+ Holds a controller that is built on first access instead of on scope handle resolution; see
+ +[CKComponentController shouldBeCreatedLazily]. Shared by the generations of a scope handle so that the controller is
+ built at most once.
+ */
+@interface CKLazyComponentController : NSObject
+
+/**
+ Builds the controller for `component` on the first call and returns the same controller afterwards. Building it
+ registers it in every scope root that registered the lazy controller and is still alive.
+ */
+- (id<CKComponentControllerProtocol> _Nullable)controllerForComponent:(id<CKComponentProtocol> _Nullable)component;
+
+/**
+ Has the controller registered in `scopeRoot` once it is built. Returns the controller if it already was, in which case
+ it is up to the caller to register it.
+ */
+- (id<CKComponentControllerProtocol> _Nullable)addScopeRoot:(CKComponentScopeRoot *)scopeRoot;
+
+/** The controller if it was built already; never builds it. */
+@property (nonatomic, strong, readonly, nullable) id<CKComponentControllerProtocol> builtController;
+
+/** The controller predicates the built controller matched, shared by every scope root that registers it. */
+@property (nonatomic, assign) CKComponentPredicateMatches predicateMatches;
+
+@end
+
 template<>
 struct std::hash<CKComponentScopeHandle *>
 {
@@ -12,11 +12,13 @@
 #include <atomic>
 
 #include <mutex>
+#include <unordered_map>
 
 #import <ComponentKit/CKInternalHelpers.h>
 #import <ComponentKit/CKTreeNode.h>
 #import <ComponentKit/CKMutex.h>
 
+#import "CKComponentController.h"
 #import "CKComponentScopeRoot.h"
 #import "CKComponentSubclass.h"
 #import "CKComponentInternal.h"
@@ -29,6 +31,35 @@
 - (void)addHandleToChain:(CKComponentScopeHandle *)component;
 @end
 
+static BOOL componentBuildsControllerLazily(id<CKComponentProtocol> component)
+{
+  const Class componentClass = [component class];
+  const Class controllerClass = [componentClass controllerClass];
+  if (controllerClass == Nil || ![controllerClass isSubclassOfClass:[CKComponentController class]]) {
+    return NO;
+  }
+
+  static CK::StaticMutex mutex = CK_MUTEX_INITIALIZER; // protects cache
+  CK::StaticMutexLocker l(mutex);
+
+  static std::unordered_map<Class, BOOL> *cache = new std::unordered_map<Class, BOOL>();
+  auto it = cache->find(componentClass);
+  if (it == cache->end()) {
+    const BOOL buildsControllerLazily =
+    [controllerClass shouldBeCreatedLazily] &&
+    [componentClass isSubclassOfClass:[CKComponent class]] &&
+    !CKSubclassOverridesInstanceMethod([CKComponent class], componentClass, @selector(buildController)) &&
+    // These are delivered to every registered controller, whether or not its component is ever mounted.
+    !CKSubclassOverridesInstanceMethod([CKComponentController class], controllerClass, @selector(didInit)) &&
+    !CKSubclassOverridesInstanceMethod([CKComponentController class], controllerClass, @selector(componentTreeWillAppear)) &&
+    !CKSubclassOverridesInstanceMethod([CKComponentController class], controllerClass, @selector(componentTreeDidDisappear)) &&
+    !CKSubclassOverridesInstanceMethod([CKComponentController class], controllerClass, @selector(invalidateController)) &&
+    !CKSubclassOverridesInstanceMethod([CKComponentController class], controllerClass, @selector(didPrepareLayout:forComponent:));
+    it = cache->insert({componentClass, buildsControllerLazily}).first;
+  }
+  return it->second;
+}
+
 @implementation CKComponentScopeHandle
 {
   id<CKComponentStateListener> __weak _listener;
@@ -37,6 +68,11 @@
   BOOL _acquired;
   BOOL _resolved;
   CKScopedResponder *_scopedResponder;
+  // Predicate matches are cached so reused components, and controllers carried over to new handles, are not re-evaluated.
+  CKComponentPredicateMatches _componentPredicateMatches;
+  CKComponentPredicateMatches _controllerPredicateMatches;
+  // Set instead of `_controller` while a lazily created controller hasn't been built yet.
+  CKLazyComponentController *_lazyController;
 }
 
 - (instancetype)initWithListener:(id<CKComponentStateListener>)listener
@@ -102,21 +138,40 @@
     }
   }
 
-  return [[CKComponentScopeHandle alloc] initWithListener:_listener
-                                         globalIdentifier:_globalIdentifier
-                                           rootIdentifier:_rootIdentifier
-                                        componentTypeName:_componentTypeName
-                                                    state:updatedState
-                                               controller:_controller
-                                          scopedResponder:_scopedResponder];
+  // Once built, a lazily created controller is carried over like any other.
+  const auto builtLazyController = _lazyController.builtController;
+  const auto handle = [[CKComponentScopeHandle alloc] initWithListener:_listener
+                                                      globalIdentifier:_globalIdentifier
+                                                        rootIdentifier:_rootIdentifier
+                                                     componentTypeName:_componentTypeName
+                                                                 state:updatedState
+                                                            controller:_controller ?: builtLazyController
+                                                       scopedResponder:_scopedResponder];
+  handle->_lazyController = builtLazyController == nil ? _lazyController : nil;
+  // The controller is carried over, so are the predicates it matched. The component will be a new one.
+  handle->_controllerPredicateMatches = builtLazyController != nil ? _lazyController.predicateMatches : _controllerPredicateMatches;
+  return handle;
 }
 
 - (id<CKComponentControllerProtocol>)controller
 {
   RCAssert(_resolved, @"Requesting controller from scope handle before resolution. The controller will be nil.");
+  if (_lazyController != nil) {
+    return [_lazyController controllerForComponent:_acquiredComponent];
+  }
   return _controller;
 }
 
+- (id<CKComponentControllerProtocol>)builtController
+{
+  return _controller ?: _lazyController.builtController;
+}
+
+- (BOOL)hasController
+{
+  return _controller != nil || _lazyController != nil;
+}
+
 - (void)dealloc
 {
   RCAssert(_resolved, @"Must be resolved before deallocation.");
@@ -166,6 +221,7 @@
 - (void)relinquishComponent
 {
   _acquiredComponent = nil;
+  _componentPredicateMatches.invalidate();
 }
 
 - (void)forceAcquireFromComponent:(id<CKComponentProtocol>)component
@@ -198,9 +254,13 @@
   // Strong ref: _acquiredComponent may be nil when rendering-to-nil as the
   // handle won't be acquired.
   const auto acquiredComponent = _acquiredComponent;
-  if (acquiredComponent != nil && _controller == nil) {
-    // Build the controller on the first non nil component.
-    _controller = [acquiredComponent buildController];
+  if (acquiredComponent != nil && _controller == nil && _lazyController == nil) {
+    // Build the controller on the first non nil component, unless it's deferred until first needed.
+    if (componentBuildsControllerLazily(acquiredComponent)) {
+      _lazyController = [CKLazyComponentController new];
+    } else {
+      _controller = [acquiredComponent buildController];
+    }
   }
 
   _resolved = YES;
@@ -210,8 +270,12 @@
 {
   // Register after scope handle resolution so the controller can be accessed
   // in the predicates.
-  [scopeRoot registerComponent:_acquiredComponent];
-  [scopeRoot registerComponentController:_controller];
+  [scopeRoot registerComponent:_acquiredComponent predicateMatches:_componentPredicateMatches];
+  if (_lazyController != nil) {
+    [scopeRoot registerLazyComponentController:_lazyController];
+  } else {
+    [scopeRoot registerComponentController:_controller predicateMatches:_controllerPredicateMatches];
+  }
 }
 
 - (CKScopedResponder *)scopedResponder
@@ -226,6 +290,71 @@
 
 @end
 
+@implementation CKLazyComponentController
+{
+  id<CKComponentControllerProtocol> _controller;
+  CKComponentPredicateMatches _predicateMatches;
+  // Scope roots to register the controller in once built.
+  NSHashTable<CKComponentScopeRoot *> *_scopeRoots;
+  std::mutex _mutex;
+}
+
+- (id<CKComponentControllerProtocol>)controllerForComponent:(id<CKComponentProtocol>)component
+{
+  id<CKComponentControllerProtocol> controller;
+  NSArray<CKComponentScopeRoot *> *scopeRoots;
+  {
+    std::lock_guard<std::mutex> l(_mutex);
+    if (_controller != nil || component == nil) {
+      return _controller;
+    }
+    _controller = [component buildController];
+    controller = _controller;
+    scopeRoots = _scopeRoots.allObjects;
+    _scopeRoots = nil;
+  }
+  // Outside the lock: registering evaluates the predicates, which may access the controller.
+  for (CKComponentScopeRoot *scopeRoot in scopeRoots) {
+    CKComponentPredicateMatches matches = self.predicateMatches;
+    [scopeRoot registerComponentController:controller predicateMatches:matches];
+    self.predicateMatches = matches;
+  }
+  return controller;
+}
+
+- (id<CKComponentControllerProtocol>)addScopeRoot:(CKComponentScopeRoot *)scopeRoot
+{
+  std::lock_guard<std::mutex> l(_mutex);
+  if (_controller != nil) {
+    return _controller;
+  }
+  if (!_scopeRoots) {
+    _scopeRoots = [NSHashTable weakObjectsHashTable];
+  }
+  [_scopeRoots addObject:scopeRoot];
+  return nil;
+}
+
+- (id<CKComponentControllerProtocol>)builtController
+{
+  std::lock_guard<std::mutex> l(_mutex);
+  return _controller;
+}
+
+- (CKComponentPredicateMatches)predicateMatches
+{
+  std::lock_guard<std::mutex> l(_mutex);
+  return _predicateMatches;
+}
+
+- (void)setPredicateMatches:(CKComponentPredicateMatches)predicateMatches
+{
+  std::lock_guard<std::mutex> l(_mutex);
+  _predicateMatches = predicateMatches;
+}
+
+@end
+
 @implementation CKScopedResponder
 {
   std::vector<__weak CKComponentScopeHandle *> _handles;
@@ -28,6 +28,7 @@
 @protocol CKComponentControllerProtocol;
 
 @class CKComponentScopeRoot;
+@class CKLazyComponentController;
 
 class CKRootTreeNode;
 struct CKStateUpdateMetadata;
@@ -70,6 +71,21 @@ struct CKStateUpdateMetadata;
 - (void)registerComponentController:(id<CKComponentControllerProtocol>)componentController;
 - (void)registerComponent:(id<CKComponentProtocol>)component;
 
+/**
+ Same as above, but consults `matches` first: if it was recorded against this root's predicates (by any generation of
+ the root) the predicates are not evaluated again. Otherwise they are evaluated and `matches` is updated.
+ */
+- (void)registerComponentController:(id<CKComponentControllerProtocol>)componentController
+                   predicateMatches:(CKComponentPredicateMatches &)matches;
+- (void)registerComponent:(id<CKComponentProtocol>)component
+         predicateMatches:(CKComponentPredicateMatches &)matches;
+
+/**
+ Registers a controller that may not be built yet, without retaining it. It is registered like any other controller when
+ it is built, and left out of enumerations until then.
+ */
+- (void)registerLazyComponentController:(CKLazyComponentController *)lazyComponentController;
+
 - (CKCocoaCollectionAdapter<id<CKComponentProtocol>>)componentsMatchingPredicate:(CKComponentPredicate)predicate;
 - (CKCocoaCollectionAdapter<id<CKComponentControllerProtocol>>)componentControllersMatchingPredicate:(CKComponentControllerPredicate)predicate;
 
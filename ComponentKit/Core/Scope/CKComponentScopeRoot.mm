@@ -11,24 +11,93 @@
 #import "CKComponentScopeRoot.h"
 
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #import <ComponentKit/CKInternalHelpers.h>
 #import <ComponentKit/CKRootTreeNode.h>
 
 #import "CKComponentProtocol.h"
 #import "CKComponentControllerProtocol.h"
+#import "CKComponentScopeHandle.h"
 #import "CKThreadLocalComponentScope.h"
 
 typedef std::unordered_map<CKComponentPredicate, NSHashTable<id<CKComponentProtocol>> *> _CKRegisteredComponentsMap;
 typedef std::unordered_map<CKComponentControllerPredicate, NSHashTable<id<CKComponentControllerProtocol>> *> _CKRegisteredComponentControllerMap;
 
+/** Predicates in a stable order, shared by every generation of a scope root so that match bits stay meaningful. */
+template <typename Predicate>
+struct _CKOrderedPredicateList {
+  /** Unique across all lists, so match bits computed against a list are never mistaken for another's. */
+  uint64_t identifier;
+  std::vector<Predicate> predicates;
+};
+
+template <typename Predicate>
+using _CKOrderedPredicates = std::shared_ptr<const _CKOrderedPredicateList<Predicate>>;
+
+/** Match bits only fit in a uint64_t; scope roots with more predicates than that always evaluate them. */
+static constexpr size_t kMaxCachedPredicateMatches = 64;
+
+template <typename Predicate>
+static _CKOrderedPredicates<Predicate> orderedPredicates(const std::unordered_set<Predicate> &predicates)
+{
+  static std::atomic<uint64_t> nextIdentifier(1);
+  return std::make_shared<const _CKOrderedPredicateList<Predicate>>(_CKOrderedPredicateList<Predicate> {
+    nextIdentifier++,
+    {predicates.begin(), predicates.end()},
+  });
+}
+
+template <typename Predicate, typename Object>
+static void registerMatchingObject(Object object,
+                                   const _CKOrderedPredicates<Predicate> &predicates,
+                                   std::unordered_map<Predicate, NSHashTable<Object> *> &registeredObjects,
+                                   CKComponentPredicateMatches &matches)
+{
+  const BOOL cached = matches.predicatesIdentifier == predicates->identifier;
+  if (!cached) {
+    matches.invalidate();
+  }
+  for (size_t i = 0; i < predicates->predicates.size(); i++) {
+    const auto predicate = predicates->predicates[i];
+    const BOOL cacheable = i < kMaxCachedPredicateMatches;
+    const uint64_t bit = cacheable ? (uint64_t)1 << i : 0;
+    BOOL matchesPredicate;
+    if (cached && cacheable) {
+      matchesPredicate = (matches.bits & bit) != 0;
+    } else {
+      matchesPredicate = predicate(object);
+      if (matchesPredicate) {
+        matches.bits |= bit;
+      }
+    }
+    if (matchesPredicate) {
+      auto hashTable = registeredObjects[predicate];
+      if (!hashTable) {
+        hashTable = [NSHashTable weakObjectsHashTable];
+        registeredObjects[predicate] = hashTable;
+      }
+      RCWarn([hashTable containsObject:object] == NO, @"Double registration of %@", [object class]);
+      [hashTable addObject:object];
+    }
+  }
+  matches.predicatesIdentifier = predicates->identifier;
+}
+
 @implementation CKComponentScopeRoot
 {
   std::unordered_set<CKComponentPredicate> _componentPredicates;
   std::unordered_set<CKComponentControllerPredicate> _componentControllerPredicates;
+  _CKOrderedPredicates<CKComponentPredicate> _orderedComponentPredicates;
+  _CKOrderedPredicates<CKComponentControllerPredicate> _orderedComponentControllerPredicates;
 
   _CKRegisteredComponentsMap _registeredComponents;
   _CKRegisteredComponentControllerMap _registeredComponentControllers;
+  // Lazily created controllers are registered when built, on whichever thread builds them, while the data source may be
+  // looking up controllers of the same root on its own queue.
+  std::mutex _registeredComponentControllersMutex; // protects _registeredComponentControllers
 
   CKRootTreeNode _rootNode;
 }
@@ -44,7 +113,9 @@ typedef std::unordered_map<CKComponentControllerPredicate, NSHashTable<id<CKComp
                                        globalIdentifier:++nextGlobalIdentifier
                                                 isEmpty:YES
                                     componentPredicates:componentPredicates
-                          componentControllerPredicates:componentControllerPredicates];
+                          componentControllerPredicates:componentControllerPredicates
+                             orderedComponentPredicates:orderedPredicates(componentPredicates)
+                   orderedComponentControllerPredicates:orderedPredicates(componentControllerPredicates)];
 }
 
 - (instancetype)newRoot
@@ -54,7 +125,9 @@ typedef std::unordered_map<CKComponentControllerPredicate, NSHashTable<id<CKComp
                                        globalIdentifier:_globalIdentifier
                                                isEmpty:NO
                                     componentPredicates:_componentPredicates
-                          componentControllerPredicates:_componentControllerPredicates];
+                          componentControllerPredicates:_componentControllerPredicates
+                             orderedComponentPredicates:_orderedComponentPredicates
+                   orderedComponentControllerPredicates:_orderedComponentControllerPredicates];
 }
 
 - (instancetype)initWithListener:(id<CKComponentStateListener>)listener
@@ -63,6 +136,8 @@ typedef std::unordered_map<CKComponentControllerPredicate, NSHashTable<id<CKComp
                          isEmpty:(BOOL)isEmpty
              componentPredicates:(const std::unordered_set<CKComponentPredicate> &)componentPredicates
    componentControllerPredicates:(const std::unordered_set<CKComponentControllerPredicate> &)componentControllerPredicates
+      orderedComponentPredicates:(const _CKOrderedPredicates<CKComponentPredicate> &)orderedComponentPredicates
+orderedComponentControllerPredicates:(const _CKOrderedPredicates<CKComponentControllerPredicate> &)orderedComponentControllerPredicates
 {
   if (self = [super init]) {
     auto const globalConfig = CKReadGlobalConfig();
@@ -71,50 +146,63 @@ typedef std::unordered_map<CKComponentControllerPredicate, NSHashTable<id<CKComp
     _globalIdentifier = globalIdentifier;
     _componentPredicates = componentPredicates;
     _componentControllerPredicates = componentControllerPredicates;
+    _orderedComponentPredicates = orderedComponentPredicates;
+    _orderedComponentControllerPredicates = orderedComponentControllerPredicates;
     _isEmpty = isEmpty;
   }
   return self;
 }
 
 - (void)registerComponent:(id<CKComponentProtocol>)component
+{
+  CKComponentPredicateMatches matches;
+  [self registerComponent:component predicateMatches:matches];
+}
+
+- (void)registerComponent:(id<CKComponentProtocol>)component predicateMatches:(CKComponentPredicateMatches &)matches
 {
   if (!component) {
     // Handle this gracefully so we don't have a bunch of nils being passed to predicates.
     return;
   }
-  for (const auto &predicate : _componentPredicates) {
-    if (predicate(component)) {
-      auto hashTable = _registeredComponents[predicate];
-      if (!hashTable) {
-        hashTable = [NSHashTable weakObjectsHashTable];
-        _registeredComponents[predicate] = hashTable;
-      }
-      RCWarn([hashTable containsObject:component] == NO, @"Double registration of component %@", component.className);
-      [hashTable addObject:component];
-    }
-  }
+  registerMatchingObject(component, _orderedComponentPredicates, _registeredComponents, matches);
+}
+
+- (void)registerComponentController:(id<CKComponentControllerProtocol>)componentController
+{
+  CKComponentPredicateMatches matches;
+  [self registerComponentController:componentController predicateMatches:matches];
 }
 
 - (void)registerComponentController:(id<CKComponentControllerProtocol>)componentController
+                   predicateMatches:(CKComponentPredicateMatches &)matches
 {
   if (!componentController) {
     // As above, handle a nil component controller gracefully instead of passing through to predicate.
     return;
   }
-  for (const auto &predicate : _componentControllerPredicates) {
-    if (predicate(componentController)) {
-      auto hashTable = _registeredComponentControllers[predicate];
-      if (!hashTable) {
-        hashTable = [NSHashTable weakObjectsHashTable];
-        _registeredComponentControllers[predicate] = hashTable;
-      }
+  std::lock_guard<std::mutex> l(_registeredComponentControllersMutex);
+  registerMatchingObject(componentController, _orderedComponentControllerPredicates, _registeredComponentControllers, matches);
+}
 
-      RCWarn([hashTable containsObject:componentController] == NO, @"Double registration of component controller %@", componentController.class);
-      [hashTable addObject:componentController];
-    }
+- (void)registerLazyComponentController:(CKLazyComponentController *)lazyComponentController
+{
+  const auto componentController = [lazyComponentController addScopeRoot:self];
+  if (componentController != nil) {
+    // The match bits live with the lazy controller, so other generations sharing it don't evaluate predicates again.
+    CKComponentPredicateMatches matches = lazyComponentController.predicateMatches;
+    [self registerComponentController:componentController predicateMatches:matches];
+    lazyComponentController.predicateMatches = matches;
   }
 }
 
+- (NSArray<id<CKComponentControllerProtocol>> *)componentControllersSnapshotMatchingPredicate:(CKComponentControllerPredicate)predicate
+{
+  std::lock_guard<std::mutex> l(_registeredComponentControllersMutex);
+  const auto componentControllersIt = _registeredComponentControllers.find(predicate);
+  return componentControllersIt != _registeredComponentControllers.end() ? componentControllersIt->second.allObjects : @[];
+}
+
 - (void)enumerateComponentsMatchingPredicate:(CKComponentPredicate)predicate
                                        block:(CKComponentScopeEnumerator)block
 {
@@ -149,20 +237,15 @@ typedef std::unordered_map<CKComponentControllerPredicate, NSHashTable<id<CKComp
   }
   RCAssert(_componentControllerPredicates.find(predicate) != _componentControllerPredicates.end(), @"Scope root must be initialized with predicate to enumerate.");
 
-  const auto foundIter = _registeredComponentControllers.find(predicate);
-  if (foundIter != _registeredComponentControllers.end()) {
-    for (id<CKComponentControllerProtocol> componentController in foundIter->second) {
-      block(componentController);
-    }
+  for (id<CKComponentControllerProtocol> componentController in [self componentControllersSnapshotMatchingPredicate:predicate]) {
+    block(componentController);
   }
 }
 
 - (CKCocoaCollectionAdapter<id<CKComponentControllerProtocol>>)componentControllersMatchingPredicate:(CKComponentControllerPredicate)predicate
 {
   RCAssert(_componentControllerPredicates.find(predicate) != _componentControllerPredicates.end(), @"Scope root must be initialized with predicate to enumerate.");
-  const auto componentControllersIt = _registeredComponentControllers.find(predicate);
-  const auto componentControllers = componentControllersIt != _registeredComponentControllers.end() ? componentControllersIt->second : @[];
-  return CKCocoaCollectionAdapter<id<CKComponentControllerProtocol>>(componentControllers);
+  return CKCocoaCollectionAdapter<id<CKComponentControllerProtocol>>([self componentControllersSnapshotMatchingPredicate:predicate]);
 }
 
 - (CKRootTreeNode &)rootNode
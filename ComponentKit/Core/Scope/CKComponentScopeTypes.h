@@ -42,4 +42,20 @@ using CKComponentPredicate = BOOL (*)(id<CKComponentProtocol>);
 using CKComponentControllerPredicate = BOOL (*)(id<CKComponentControllerProtocol>);
 using CKMountablePredicate = BOOL (*)(id<CKMountable>);
 
+/**
+ Remembers which of a scope root's predicates an object matched, as one bit per predicate. Scope roots of the same lineage
+ share their ordered predicate list, so an object carried over from a previous generation can replay these bits instead
+ of running every predicate again.
+ */
+struct CKComponentPredicateMatches {
+  /**
+   Identifier of the ordered predicate list `bits` was computed against, or 0 when nothing was recorded. Identifiers are
+   never reused, unlike the address of a list that has been freed.
+   */
+  uint64_t predicatesIdentifier = 0;
+  uint64_t bits = 0;
+
+  void invalidate() { predicatesIdentifier = 0; bits = 0; }
+};
+
 #endif
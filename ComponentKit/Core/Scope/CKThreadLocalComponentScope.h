@@ -12,7 +12,6 @@
 
 #if CK_NOT_SWIFT
 
-#import <stack>
 #import <vector>
 
 #import <Foundation/Foundation.h>
@@ -27,6 +26,54 @@
 
 @protocol CKSystraceListener;
 
+/**
+ A flattened replacement for the parallel scope pair, keys and `ancestorHasStateUpdate` stacks that are maintained
+ while building a component tree.
+
+ Every push/pop only moves a depth index over a preallocated array of frames; frames keep the capacity of their
+ keys vector when popped, and the whole storage is recycled across builds on the same thread. In steady state
+ building a tree therefore doesn't allocate per scope level.
+ */
+class CKComponentScopeFrameStack {
+public:
+  struct Frame {
+    CKComponentScopePair pair;
+    std::vector<id<NSObject>> keys;
+    size_t keysFrameIndex;
+    BOOL ancestorHasStateUpdate;
+  };
+
+  CKComponentScopeFrameStack() noexcept;
+  ~CKComponentScopeFrameStack();
+
+  CKComponentScopeFrameStack(const CKComponentScopeFrameStack &) = delete;
+  CKComponentScopeFrameStack &operator=(const CKComponentScopeFrameStack &) = delete;
+
+  /** Pushes a new frame. Frames that don't start a keys level share the keys of the closest frame that did. */
+  void push(const CKComponentScopePair &pair, BOOL startsKeysLevel, BOOL ancestorHasStateUpdate) noexcept;
+  /** Pushes a new frame inheriting `ancestorHasStateUpdate` from the current top frame. */
+  void push(const CKComponentScopePair &pair, BOOL startsKeysLevel) noexcept;
+  void pop() noexcept;
+
+  CKComponentScopePair &top() noexcept { return topFrame().pair; }
+  const CKComponentScopePair &top() const noexcept { return topFrame().pair; }
+  size_t size() const noexcept { return _depth; }
+  bool empty() const noexcept { return _depth == 0; }
+
+  /** The keys of the current keys level; see `CKComponentKey`. */
+  std::vector<id<NSObject>> &keys() noexcept { return (*_frames)[topFrame().keysFrameIndex].keys; }
+  BOOL ancestorHasStateUpdate() const noexcept { return _depth > 0 && topFrame().ancestorHasStateUpdate; }
+  /** YES if the top frame started its own keys level. */
+  BOOL topStartsKeysLevel() const noexcept { return topFrame().keysFrameIndex == _depth - 1; }
+
+private:
+  Frame &topFrame() noexcept { return (*_frames)[_depth - 1]; }
+  const Frame &topFrame() const noexcept { return (*_frames)[_depth - 1]; }
+
+  std::vector<Frame> *_frames;
+  size_t _depth;
+};
+
 class CKThreadLocalComponentScope {
 public:
   CKThreadLocalComponentScope(CKComponentScopeRoot *previousScopeRoot,
@@ -51,9 +98,7 @@ public:
   CK::NonNull<CKComponentScopeRoot *> const newScopeRoot;
   CKComponentScopeRoot *const previousScopeRoot;
   const CKComponentStateUpdateMap stateUpdates;
-  std::stack<CKComponentScopePair> stack;
-  std::stack<std::vector<id<NSObject>>> keys;
-  std::stack<BOOL> ancestorHasStateUpdate;
+  CKComponentScopeFrameStack stack;
 
   /** The current systrace listener. Can be nil if systrace is not enabled. */
   id<CKSystraceListener> systraceListener;
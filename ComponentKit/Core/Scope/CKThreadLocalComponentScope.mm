@@ -11,7 +11,6 @@
 #import "CKThreadLocalComponentScope.h"
 
 #import <pthread.h>
-#import <stack>
 
 #import <RenderCore/RCAssert.h>
 #import <ComponentKit/CKAnalyticsListener.h>
@@ -36,6 +35,79 @@ CKThreadLocalComponentScope *CKThreadLocalComponentScope::currentScope() noexcep
   return (CKThreadLocalComponentScope *)pthread_getspecific(_threadKey());
 }
 
+using CKComponentScopeFrames = std::vector<CKComponentScopeFrameStack::Frame>;
+
+/** Deep trees rarely go past this many scope levels; reserving upfront avoids regrowing while building. */
+static constexpr size_t kInitialFrameCapacity = 64;
+
+static void _deleteCachedFrames(void *frames) noexcept
+{
+  delete (CKComponentScopeFrames *)frames;
+}
+
+/** Frame storage parked by the last finished build on this thread, ready to be picked up by the next one. */
+static pthread_key_t _framesCacheKey() noexcept
+{
+  static pthread_key_t frames_key;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    (void)pthread_key_create(&frames_key, _deleteCachedFrames);
+  });
+  return frames_key;
+}
+
+CKComponentScopeFrameStack::CKComponentScopeFrameStack() noexcept
+: _frames((CKComponentScopeFrames *)pthread_getspecific(_framesCacheKey())), _depth(0)
+{
+  if (_frames != nullptr) {
+    // Nested builds on the same thread won't find a cached storage and will allocate their own.
+    pthread_setspecific(_framesCacheKey(), nullptr);
+  } else {
+    _frames = new CKComponentScopeFrames();
+    _frames->reserve(kInitialFrameCapacity);
+  }
+}
+
+CKComponentScopeFrameStack::~CKComponentScopeFrameStack()
+{
+  RCCAssert(_depth == 0, @"Expected all frames to be popped, %zu left", _depth);
+  if (pthread_getspecific(_framesCacheKey()) == nullptr) {
+    pthread_setspecific(_framesCacheKey(), _frames);
+  } else {
+    delete _frames;
+  }
+}
+
+void CKComponentScopeFrameStack::push(const CKComponentScopePair &pair, BOOL startsKeysLevel, BOOL ancestorHasStateUpdate) noexcept
+{
+  const auto keysFrameIndex = (startsKeysLevel || _depth == 0) ? _depth : topFrame().keysFrameIndex;
+  if (_depth == _frames->size()) {
+    _frames->push_back({.pair = pair, .keysFrameIndex = keysFrameIndex, .ancestorHasStateUpdate = ancestorHasStateUpdate});
+  } else {
+    // Reuse a previously popped frame, keeping the capacity of its keys vector.
+    auto &frame = (*_frames)[_depth];
+    frame.pair = pair;
+    frame.keysFrameIndex = keysFrameIndex;
+    frame.ancestorHasStateUpdate = ancestorHasStateUpdate;
+  }
+  _depth++;
+}
+
+void CKComponentScopeFrameStack::push(const CKComponentScopePair &pair, BOOL startsKeysLevel) noexcept
+{
+  push(pair, startsKeysLevel, ancestorHasStateUpdate());
+}
+
+void CKComponentScopeFrameStack::pop() noexcept
+{
+  RCCAssert(_depth > 0, @"Popping an empty scope frame stack");
+  auto &frame = topFrame();
+  // Don't keep tree nodes alive past the build that created them.
+  frame.pair = {};
+  frame.keys.clear();
+  _depth--;
+}
+
 CKThreadLocalComponentScope::CKThreadLocalComponentScope(CKComponentScopeRoot *previousScopeRoot,
                                                          const CKComponentStateUpdateMap &updates,
                                                          CKBuildTrigger trigger,
@@ -58,45 +130,35 @@ CKThreadLocalComponentScope::CKThreadLocalComponentScope(CKComponentScopeRoot *p
   enforceCKComponentSubclasses(enforceCKComponentSubclasses),
   previousScope(CKThreadLocalComponentScope::currentScope())
 {
-  stack.push({[newScopeRoot rootNode].node(), previousScopeRoot.rootNode.node()});
-  keys.push({});
-  ancestorHasStateUpdate.push(NO);
+  stack.push({[newScopeRoot rootNode].node(), previousScopeRoot.rootNode.node()}, YES, NO);
   pthread_setspecific(_threadKey(), this);
 }
 
 CKThreadLocalComponentScope::~CKThreadLocalComponentScope()
 {
+  RCCAssert(stack.size() == 1 && stack.keys().empty(), @"Expected keys to be at initial state in destructor");
+  RCCAssert(stack.ancestorHasStateUpdate() == NO, @"Expected ancestorHasStateUpdate to be at initial state in destructor");
   stack.pop();
   RCCAssert(stack.empty(), @"Didn't expect stack to contain anything in destructor");
-  RCCAssert(keys.size() == 1 && keys.top().empty(), @"Expected keys to be at initial state in destructor");
-  RCCAssert(ancestorHasStateUpdate.size() == 1 && ancestorHasStateUpdate.top() == NO, @"Expected ancestorHasStateUpdate to be at initial state in destructor");
   pthread_setspecific(_threadKey(), previousScope);
 }
 
 void CKThreadLocalComponentScope::push(CKComponentScopePair scopePair, BOOL keysSupportEnabled) noexcept {
-  stack.push(std::move(scopePair));
-  if (keysSupportEnabled) {
-    keys.push({});
-  }
+  stack.push(scopePair, keysSupportEnabled);
 }
 
 void CKThreadLocalComponentScope::push(CKComponentScopePair scopePair, BOOL keysSupportEnabled, BOOL ancestorHasStateUpdateValue) noexcept {
-  push(scopePair, keysSupportEnabled);
-  ancestorHasStateUpdate.push(ancestorHasStateUpdateValue);
+  stack.push(scopePair, keysSupportEnabled, ancestorHasStateUpdateValue);
 }
 
 void CKThreadLocalComponentScope::pop(BOOL keysSupportEnabled, BOOL ancestorStateUpdateSupportEnabled) noexcept {
-  stack.pop();
+  RCCAssert((bool)stack.topStartsKeysLevel() == (bool)keysSupportEnabled, @"Push and pop should agree on keys support");
   if (keysSupportEnabled) {
     RCCAssert(
-        keys.top().empty(),
+        stack.keys().empty(),
         @"Expected keys to be cleared on pop");
-    keys.pop();
-  }
-
-  if (ancestorStateUpdateSupportEnabled) {
-    ancestorHasStateUpdate.pop();
   }
+  stack.pop();
 }
 
 void CKThreadLocalComponentScope::markCurrentScopeWithRenderComponentInTree() noexcept
@@ -346,7 +346,7 @@ CKTreeNode *CKSwiftCreateNode(Class klass, id identifier) {
                                                    newRoot:threadLocalScope->newScopeRoot
                                          componentTypeName:class_getName(klass)
                                                 identifier:identifier
-                                                      keys:threadLocalScope->keys.top()
+                                                      keys:threadLocalScope->stack.keys()
                                        initialStateCreator:^{ return [CKSwiftStateWrapper new]; }
                                               stateUpdates:threadLocalScope->stateUpdates
                                        requiresScopeHandle:YES];
@@ -41,6 +41,13 @@
 - (void)setRootLayout:(const CKComponentRootLayout &)rootLayout;
 - (void)setBoundsAnimation:(const CKComponentBoundsAnimation &)boundsAnimation;
 - (void)setComponent:(CKComponent *)component;
+/**
+ Restricts mounting to the parts of the layout above and below the visible rect, remounting as it moves vertically;
+ CGRectNull mounts the whole layout. The rect is in the container view's coordinate space.
+ */
+- (void)setVisibleRect:(CGRect)visibleRect;
+/** When positive, layouts are mounted in slices of this many seconds per main run loop turn; see CKComponentHostingView. */
+- (void)setMountSliceBudget:(CFTimeInterval)mountSliceBudget;
 
 - (void)mount;
 - (void)unmount;
@@ -64,6 +64,11 @@ private:
   CK::DelayedNonNull<CKComponentHostingContainerView *> _containerView;
   CKComponentAttachController *_attachController;
   BOOL _needsMount;
+
+  CGRect _visibleRect;
+  /** The rect passed to the attach controller when the current layout was last mounted. */
+  CGRect _mountRect;
+  CFTimeInterval _mountSliceBudget;
 }
 
 - (instancetype)initWithFrame:(CGRect)frame
@@ -75,6 +80,8 @@ private:
   if (self = [super init]) {
     _scopeIdentifier = scopeIdentifier;
     _analyticsListener = analyticsListener;
+    _visibleRect = CGRectNull;
+    _mountRect = CGRectInfinite;
 
     _attachController = [CKComponentAttachController new];
 
@@ -113,6 +120,48 @@ private:
   [_containerView setComponent:component];
 }
 
+/** All of the container between minY and maxY; mounting is only culled along the vertical scroll axis. */
+static CGRect verticalBand(CGFloat minY, CGFloat maxY)
+{
+  return {{CGRectGetMinX(CGRectInfinite), minY}, {CGRectGetWidth(CGRectInfinite), maxY - minY}};
+}
+
+/**
+ Extends the visible rect by its own height above and below, so that up to a screen's worth of content on either side is
+ mounted before it scrolls into view.
+ */
+static CGRect mountRectForVisibleRect(CGRect visibleRect)
+{
+  if (CGRectIsNull(visibleRect)) {
+    return CGRectInfinite;
+  }
+  const auto height = CGRectGetHeight(visibleRect);
+  return verticalBand(CGRectGetMinY(visibleRect) - height, CGRectGetMaxY(visibleRect) + height);
+}
+
+- (void)setVisibleRect:(CGRect)visibleRect
+{
+  RCAssertMainThread();
+  _visibleRect = visibleRect;
+  // Only remount once the visible rect, with half of its prefetch margin, is no longer covered by what is mounted; this
+  // keeps remounts to a few per screen of scrolling, and horizontal scrolling never remounts.
+  const auto requiredRect =
+  CGRectIsNull(visibleRect)
+  ? CGRectInfinite
+  : verticalBand(CGRectGetMinY(visibleRect) - CGRectGetHeight(visibleRect) / 2,
+                 CGRectGetMaxY(visibleRect) + CGRectGetHeight(visibleRect) / 2);
+  if (!_needsMount && _layoutProvider && !CGRectContainsRect(_mountRect, requiredRect)) {
+    _needsMount = YES;
+    [self mount];
+  }
+}
+
+- (void)setMountSliceBudget:(CFTimeInterval)mountSliceBudget
+{
+  RCAssertMainThread();
+  _mountSliceBudget = mountSliceBudget;
+}
+
 - (void)mount
 {
   RCAssertMainThread();
@@ -124,6 +173,7 @@ private:
     [_attachController detachComponentLayoutWithScopeIdentifier:_scopeIdentifier];
     return;
   }
+  _mountRect = mountRectForVisibleRect(_visibleRect);
   CKComponentAttachControllerAttachComponentRootLayout(_attachController,
   {
     .layoutProvider = _layoutProvider,
@@ -131,6 +181,9 @@ private:
     .boundsAnimation = _boundsAnimation,
     .view = _containerView,
     .analyticsListener = _analyticsListener,
+    .mountRect = _mountRect,
+    .mountSliceBudget = _mountSliceBudget,
+    .visibleRect = CGRectIsNull(_visibleRect) ? CGRectInfinite : _visibleRect,
   });
   _previousLayoutProvider = nil;
   _boundsAnimation = {};
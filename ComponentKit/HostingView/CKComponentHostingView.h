@@ -25,6 +25,20 @@ NS_SWIFT_NAME(ComponentHostingView)
 /** Notified when the view's ideal size (measured by -sizeThatFits:) may have changed. */
 @property (nonatomic, weak) id<CKComponentHostingViewDelegate> delegate;
 
+/**
+ The part of the view that is currently on screen, in the view's own coordinate space. When set, only components near
+ this rect vertically are mounted and mounting follows the rect as it changes; defaults to CGRectNull, which mounts
+ everything. Mounting is never culled horizontally. Useful for tall hosting views placed inside a vertical scroll view.
+ */
+@property (nonatomic, assign) CGRect visibleRect;
+
+/**
+ When positive, layouts are mounted over several main run loop turns, spending at most about this many seconds per turn
+ and starting with the components overlapping visibleRect, so that mounting a large layout doesn't drop frames. Component
+ animations are not applied to such mounts. Defaults to 0, which mounts each layout at once.
+ */
+@property (nonatomic, assign) CFTimeInterval mountSliceBudget;
+
 #if CK_NOT_SWIFT
 
 /**
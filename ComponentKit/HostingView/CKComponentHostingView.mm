@@ -114,6 +114,7 @@ static auto nilProvider(id<NSObject>, id<NSObject>) -> CKComponent * { return ni
      sizeRangeProvider:sizeRangeProvider
      allowTapPassthrough:_allowTapPassthrough];
     [self addSubview:self.containerView];
+    _visibleRect = CGRectNull;
 
     _initialSize = options.initialSize;
     _initialSize.apply([&](const auto initialSize) {
@@ -131,6 +132,23 @@ static auto nilProvider(id<NSObject>, id<NSObject>) -> CKComponent * { return ni
   return _containerViewProvider.containerView;
 }
 
+- (void)setVisibleRect:(CGRect)visibleRect
+{
+  RCAssertMainThread();
+  if (CGRectEqualToRect(_visibleRect, visibleRect)) {
+    return;
+  }
+  _visibleRect = visibleRect;
+  [_containerViewProvider setVisibleRect:visibleRect];
+}
+
+- (void)setMountSliceBudget:(CFTimeInterval)mountSliceBudget
+{
+  RCAssertMainThread();
+  _mountSliceBudget = mountSliceBudget;
+  [_containerViewProvider setMountSliceBudget:mountSliceBudget];
+}
+
 #pragma mark - Layout
 
 - (void)layoutSubviews
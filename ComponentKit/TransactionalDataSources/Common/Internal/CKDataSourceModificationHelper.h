@@ -29,6 +29,7 @@ CKDataSourceItem *CKBuildDataSourceItem(CK::NonNull<CKComponentScopeRoot *> prev
                                         id model,
                                         id context,
                                         std::shared_ptr<RCLayoutCache> treeLayoutCache = nullptr,
-                                        CKReflowTrigger reflowTrigger = CKReflowTriggerNone);
+                                        CKReflowTrigger reflowTrigger = CKReflowTriggerNone,
+                                        const CKComponentRootLayout *previousRootLayout = nullptr);
 
 #endif
@@ -27,7 +27,8 @@ CKDataSourceItem *CKBuildDataSourceItem(CK::NonNull<CKComponentScopeRoot *> prev
                                         id model,
                                         id context,
                                         std::shared_ptr<RCLayoutCache> layoutCache,
-                                        CKReflowTrigger reflowTrigger)
+                                        CKReflowTrigger reflowTrigger,
+                                        const CKComponentRootLayout *previousRootLayout)
 {
   CKExceptionInfoScopedValue itemDescription(@"ck_data_source_item_description", [model description]);
 
@@ -50,7 +51,8 @@ CKDataSourceItem *CKBuildDataSourceItem(CK::NonNull<CKComponentScopeRoot *> prev
                                                          [result.scopeRoot analyticsListener],
                                                          result.buildTrigger,
                                                          result.scopeRoot,
-                                                         layoutCache);
+                                                         layoutCache,
+                                                         previousRootLayout);
   
   return [[CKDataSourceItem alloc] initWithRootLayout:rootLayout
                                                 model:model
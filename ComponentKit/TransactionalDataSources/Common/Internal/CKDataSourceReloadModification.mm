@@ -57,7 +57,7 @@ using namespace CKComponentControllerHelper;
       [updatedIndexPaths addObject:[NSIndexPath indexPathForItem:itemIdx inSection:sectionIdx]];
       // On reload, we would like avoid component reuse - by passing `enableComponentReuseOptimizations = NO`, we make sure that all the components will be recreated.
       const auto layoutCache = _treeLayoutCache ? _treeLayoutCache->find([item.scopeRoot globalIdentifier]) : nullptr;
-      CKDataSourceItem *const newItem = CKBuildDataSourceItem([item scopeRoot], {}, sizeRange, configuration, [item model], context, layoutCache, CKReflowTriggerReload);
+      CKDataSourceItem *const newItem = CKBuildDataSourceItem([item scopeRoot], {}, sizeRange, configuration, [item model], context, layoutCache, CKReflowTriggerReload, &[item rootLayout]);
       [newItems addObject:newItem];
       for (auto componentController : addedControllersFromPreviousScopeRootMatchingPredicate(newItem.scopeRoot,
                                                                                                    item.scopeRoot,
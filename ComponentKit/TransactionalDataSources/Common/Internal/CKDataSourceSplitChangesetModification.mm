@@ -140,7 +140,7 @@ using namespace CKComponentControllerHelper;
       }
       CKDataSourceItem *const oldItem = section[indexPath.item];
       const auto layoutCache = _treeLayoutCache ? _treeLayoutCache->find([oldItem.scopeRoot globalIdentifier]) : nullptr;
-      CKDataSourceItem *const item = CKBuildDataSourceItem([oldItem scopeRoot], {}, sizeRange, configuration, model, context, layoutCache);
+      CKDataSourceItem *const item = CKBuildDataSourceItem([oldItem scopeRoot], {}, sizeRange, configuration, model, context, layoutCache, CKReflowTriggerNone, &[oldItem rootLayout]);
       [section replaceObjectAtIndex:indexPath.item withObject:item];
       for (auto componentController : addedControllersFromPreviousScopeRootMatchingPredicate(item.scopeRoot,
                                                                                                    oldItem.scopeRoot,
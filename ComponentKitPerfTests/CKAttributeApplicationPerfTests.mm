@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <memory>
+#import <string>
+#import <vector>
+
+#import <ComponentKit/CKComponentViewAttribute.h>
+#import <ComponentKit/CKViewConfiguration.h>
+#import <ComponentKit/ComponentViewManager.h>
+
+// Views are remounted with configurations of 5 to 20 attributes, half of which change value between configurations.
+#define VIEW_COUNT 1000
+#define MIN_ATTRIBUTE_COUNT 5
+#define MAX_ATTRIBUTE_COUNT 20
+
+@interface CKAttributeApplicationPerfTests : XCTestCase
+@end
+
+@implementation CKAttributeApplicationPerfTests
+
+static std::vector<CKComponentViewAttribute> attributes()
+{
+  std::vector<CKComponentViewAttribute> attributes;
+  for (int i = 0; i < MAX_ATTRIBUTE_COUNT; i++) {
+    attributes.push_back({"CKAttributeApplicationPerfTests-" + std::to_string(i), ^(UIView *view, id value){}});
+  }
+  return attributes;
+}
+
+static CKViewConfiguration viewConfiguration(const std::vector<CKComponentViewAttribute> &attributes,
+                                             size_t attributeCount,
+                                             NSUInteger generation)
+{
+  CKViewComponentAttributeValueMap map;
+  for (size_t i = 0; i < attributeCount; i++) {
+    // Attributes are added in reverse so the map can't rely on insertion order.
+    map.insert({attributes[attributeCount - 1 - i], (i % 2 == 0) ? @(generation) : @(i)});
+  }
+  return CKViewConfiguration([UIView class], std::move(map));
+}
+
+- (void)testPerformanceOfApplyingAttributes
+{
+  const auto attrs = attributes();
+  std::vector<CKViewConfiguration> configurations[2];
+  NSMutableArray<UIView *> *views = [NSMutableArray array];
+  for (NSUInteger i = 0; i < VIEW_COUNT; i++) {
+    const size_t attributeCount = MIN_ATTRIBUTE_COUNT + i % (MAX_ATTRIBUTE_COUNT - MIN_ATTRIBUTE_COUNT + 1);
+    configurations[0].push_back(viewConfiguration(attrs, attributeCount, 0));
+    configurations[1].push_back(viewConfiguration(attrs, attributeCount, 1));
+    [views addObject:[UIView new]];
+  }
+  const auto firstConfigurations = configurations[0].data();
+  const auto secondConfigurations = configurations[1].data();
+
+  [self measureBlock:^{
+    for (NSUInteger i = 0; i < VIEW_COUNT; i++) {
+      CK::Component::AttributeApplicator::apply(views[i], firstConfigurations[i]);
+    }
+    for (NSUInteger i = 0; i < VIEW_COUNT; i++) {
+      CK::Component::AttributeApplicator::apply(views[i], secondConfigurations[i]);
+    }
+  }];
+}
+
+- (void)testPerformanceOfApplyingPreparedAttributes
+{
+  const auto attrs = attributes();
+  std::vector<CKViewConfiguration> configurations[2];
+  NSMutableArray<UIView *> *views = [NSMutableArray array];
+  for (NSUInteger i = 0; i < VIEW_COUNT; i++) {
+    const size_t attributeCount = MIN_ATTRIBUTE_COUNT + i % (MAX_ATTRIBUTE_COUNT - MIN_ATTRIBUTE_COUNT + 1);
+    configurations[0].push_back(viewConfiguration(attrs, attributeCount, 0));
+    configurations[1].push_back(viewConfiguration(attrs, attributeCount, 1));
+    [views addObject:[UIView new]];
+  }
+  // As done off the main thread when computing a layout, diff each configuration against the one its view shows.
+  const auto preparation = std::make_shared<CK::Component::MountPreparation>();
+  for (NSUInteger i = 0; i < VIEW_COUNT; i++) {
+    preparation->prepare(configurations[0][i], configurations[1][i]);
+    preparation->prepare(configurations[1][i], configurations[0][i]);
+  }
+  for (NSUInteger i = 0; i < VIEW_COUNT; i++) {
+    CK::Component::AttributeApplicator::apply(views[i], configurations[0][i]);
+  }
+  const auto firstConfigurations = configurations[0].data();
+  const auto secondConfigurations = configurations[1].data();
+  const auto prepared = preparation.get();
+
+  [self measureBlock:^{
+    for (NSUInteger i = 0; i < VIEW_COUNT; i++) {
+      CK::Component::AttributeApplicator::apply(views[i], secondConfigurations[i], prepared);
+    }
+    for (NSUInteger i = 0; i < VIEW_COUNT; i++) {
+      CK::Component::AttributeApplicator::apply(views[i], firstConfigurations[i], prepared);
+    }
+  }];
+}
+
+@end
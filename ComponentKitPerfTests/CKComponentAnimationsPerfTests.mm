@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <ComponentKit/CKBuildComponent.h>
+#import <ComponentKit/CKComponentAnimations.h>
+#import <ComponentKit/CKComponentLayout.h>
+#import <ComponentKit/CKComponentScope.h>
+#import <ComponentKit/CKComponentScopeRootFactory.h>
+#import <ComponentKit/CKComponentSubclass.h>
+#import <ComponentKit/CKCompositeComponent.h>
+#import <ComponentKit/CKFlexboxComponent.h>
+
+// 100 groups of 100 animated leaves; a single group changes between generations.
+#define GROUP_COUNT 100
+#define LEAVES_PER_GROUP 100
+
+@interface CKAnimatedLeafComponent : CKComponent
++ (instancetype)newWithIdentifier:(NSUInteger)identifier;
+@end
+
+@implementation CKAnimatedLeafComponent
++ (instancetype)newWithIdentifier:(NSUInteger)identifier
+{
+  CKComponentScope scope(self, @(identifier));
+  return [super newWithView:{} size:{1, 1}];
+}
+- (std::vector<CKComponentAnimation>)animationsFromPreviousComponent:(CKComponent *)previousComponent { return {}; }
+@end
+
+@interface CKAnimatedGroupComponent : CKCompositeComponent
++ (instancetype)newWithIdentifier:(NSUInteger)identifier generation:(NSUInteger)generation;
+@end
+
+@implementation CKAnimatedGroupComponent
++ (instancetype)newWithIdentifier:(NSUInteger)identifier generation:(NSUInteger)generation
+{
+  CKComponentScope scope(self, @(identifier));
+  return [super newWithView:{} props:@(generation) childProvider:^{
+    std::vector<CKFlexboxComponentChild> children;
+    for (NSUInteger i = 0; i < LEAVES_PER_GROUP; i++) {
+      children.push_back({[CKAnimatedLeafComponent newWithIdentifier:i]});
+    }
+    return [[CKFlexboxComponent alloc] initWithView:{} size:{} style:{} children:std::move(children)];
+  }];
+}
+@end
+
+static CKComponent *rootComponent(NSUInteger changedGroup, NSUInteger generation)
+{
+  std::vector<CKFlexboxComponentChild> groups;
+  for (NSUInteger i = 0; i < GROUP_COUNT; i++) {
+    groups.push_back({[CKAnimatedGroupComponent newWithIdentifier:i generation:(i == changedGroup ? generation : 0)]});
+  }
+  return [[CKFlexboxComponent alloc] initWithView:{} size:{} style:{} children:std::move(groups)];
+}
+
+@interface CKComponentAnimationsPerfTests : XCTestCase
+@end
+
+@implementation CKComponentAnimationsPerfTests
+
+- (void)testPerformanceOfDiffingLayoutsWithOnePercentChange
+{
+  const auto sizeRange = CKSizeRange {CGSizeZero, {INFINITY, INFINITY}};
+  const auto firstResult = CKBuildComponent(CKComponentScopeRootWithDefaultPredicates(nil, nil), {}, ^{
+    return rootComponent(0, 0);
+  });
+  const auto secondResult = CKBuildComponent(firstResult.scopeRoot, {}, ^{
+    return rootComponent(GROUP_COUNT / 2, 1);
+  });
+  const auto previousLayout = CKComputeRootComponentLayout(firstResult.component, sizeRange, nil);
+  const auto layout = CKComputeRootComponentLayout(secondResult.component, sizeRange, nil);
+
+  __block size_t updatedComponentsCount = 0;
+  [self measureBlock:^{
+    const auto diff = CK::animatedComponentsBetweenLayouts(layout, previousLayout);
+    updatedComponentsCount = diff.updatedComponents.size();
+  }];
+  XCTAssertEqual(updatedComponentsCount, LEAVES_PER_GROUP);
+}
+
+@end
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <memory>
+#import <vector>
+
+#import <ComponentKit/CKComponent.h>
+#import <ComponentKit/CKComponentLayout.h>
+#import <ComponentKit/CKComponentSubclass.h>
+
+// 10 rows of 100 leaves, plus the rows and the root: just over 1k nodes, with a view for every other leaf.
+#define ROW_COUNT 10
+#define LEAVES_PER_ROW 100
+
+static RCLayout layoutWithThousandNodes()
+{
+  std::vector<RCLayoutChild> rows;
+  for (NSUInteger i = 0; i < ROW_COUNT; i++) {
+    std::vector<RCLayoutChild> leaves;
+    for (NSUInteger j = 0; j < LEAVES_PER_ROW; j++) {
+      CKComponent *const leaf =
+      j % 2 == 0
+      ? [CKComponent newWithView:{[UIView class]} size:{}]
+      : [CKComponent newWithView:{} size:{}];
+      leaves.push_back({{(CGFloat)j, 0}, {leaf, {1, 1}}});
+    }
+    rows.push_back({{0, (CGFloat)i}, {[CKComponent newWithView:{} size:{}], {LEAVES_PER_ROW, 1}, std::move(leaves)}});
+  }
+  return {[CKComponent newWithView:{[UIView class]} size:{}], {LEAVES_PER_ROW, ROW_COUNT}, std::move(rows)};
+}
+
+@interface CKMountLayoutPerfTests : XCTestCase
+@end
+
+@implementation CKMountLayoutPerfTests
+
+- (void)testPerformanceOfRemountingThousandNodeLayout
+{
+  const auto firstPlan = std::make_shared<const RCMountPlan>(layoutWithThousandNodes());
+  const auto secondPlan = std::make_shared<const RCMountPlan>(layoutWithThousandNodes());
+  UIView *const container = [UIView new];
+  __block NSSet *mountedComponents = CKMountComponentLayout(*firstPlan, container, nil, nil);
+
+  // Each iteration mounts a new tree over the previous one, so every component is mounted once and unmounted once.
+  [self measureBlock:^{
+    mountedComponents = CKMountComponentLayout(*secondPlan, container, mountedComponents, nil);
+    mountedComponents = CKMountComponentLayout(*firstPlan, container, mountedComponents, nil);
+  }];
+  CKUnmountComponents(mountedComponents);
+}
+
+- (void)testPerformanceOfBuildingMountPlanForThousandNodeLayout
+{
+  const auto layout = layoutWithThousandNodes();
+  __block size_t itemCount = 0;
+  [self measureBlock:^{
+    for (auto i = 0; i < 100; i++) {
+      const RCMountPlan plan(layout);
+      itemCount = plan.items().size();
+    }
+  }];
+  XCTAssertEqual(itemCount, (size_t)(1 + ROW_COUNT * (1 + LEAVES_PER_ROW)));
+}
+
+@end
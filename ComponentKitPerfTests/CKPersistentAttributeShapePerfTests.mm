@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <vector>
+
+#import <ComponentKit/CKComponentViewAttribute.h>
+
+// Need enough iterations for signal
+
+#define TEST_ITERATIONS (100 * 1000)
+#define THREAD_COUNT 8
+
+@interface CKPersistentAttributeShapePerfTests : XCTestCase
+@end
+
+@implementation CKPersistentAttributeShapePerfTests
+
+static std::vector<CKViewComponentAttributeValueMap> attributeMaps()
+{
+  const std::vector<CKComponentViewAttribute> attributes {
+    @selector(setBackgroundColor:),
+    @selector(setAlpha:),
+    @selector(setTag:),
+    @selector(setClipsToBounds:),
+    @selector(setUserInteractionEnabled:),
+    CKComponentViewAttribute::LayerAttribute(@selector(setCornerRadius:)),
+    CKComponentViewAttribute::LayerAttribute(@selector(setBorderWidth:)),
+  };
+  std::vector<CKViewComponentAttributeValueMap> maps;
+  for (size_t i = 1; i <= attributes.size(); i++) {
+    CKViewComponentAttributeValueMap map;
+    for (size_t j = 0; j < i; j++) {
+      map.insert({attributes[j], @1});
+    }
+    maps.push_back(map);
+  }
+  return maps;
+}
+
+- (void)testPerformanceOfComputingAttributeShapesOnOneThread
+{
+  const auto maps = attributeMaps();
+  [self measureBlock:^{
+    for (auto i = 0; i < TEST_ITERATIONS; i++) {
+      CK::Component::PersistentAttributeShape shape(maps[i % maps.size()]);
+    }
+  }];
+}
+
+- (void)testPerformanceOfComputingAttributeShapesOnContendedThreads
+{
+  const auto maps = attributeMaps();
+  [self measureBlock:^{
+    dispatch_apply(THREAD_COUNT, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t thread) {
+      for (auto i = 0; i < TEST_ITERATIONS / THREAD_COUNT; i++) {
+        CK::Component::PersistentAttributeShape shape(maps[(i + thread) % maps.size()]);
+      }
+    });
+  }];
+}
+
+@end
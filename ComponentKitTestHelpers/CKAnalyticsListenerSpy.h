@@ -37,6 +37,8 @@ using Event = Variant<DidReceiveStateUpdate>;
 @property(atomic, readonly) NSInteger willMountComponentHitCount;
 @property(atomic, readonly) NSInteger didMountComponentHitCount;
 @property(atomic, readonly) NSInteger viewAllocationsCount;
+@property(atomic, readonly) NSInteger memoizedSubtreesReusedCount;
+@property(atomic, readonly) NSInteger memoizedSubtreesRebuiltCount;
 @property(atomic, readonly) std::vector<CK::AnalyticsListenerSpy::Event> events;
 
 @end
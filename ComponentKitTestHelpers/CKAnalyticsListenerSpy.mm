@@ -22,6 +22,8 @@ using namespace CK::AnalyticsListenerSpy;
 @property(atomic) NSInteger willCollectAnimationsHitCount;
 @property(atomic) NSInteger didCollectAnimationsHitCount;
 @property(atomic) NSInteger willMountComponentHitCount;
+@property(atomic) NSInteger memoizedSubtreesReusedCount;
+@property(atomic) NSInteger memoizedSubtreesRebuiltCount;
 @end
 
 @implementation CKAnalyticsListenerSpy {
@@ -116,8 +118,19 @@ inComponentTreeWithRootComponent:(id<CKMountable>)component
 
 - (BOOL)shouldCollectMountInformationForRootComponent:(CKComponent *)component { return YES; }
 
+- (BOOL)shouldCollectMountTraceForRootComponent:(CKComponent *)component { return NO; }
+
 - (void)didReuseNode:(CKTreeNode *)node inScopeRoot:(CKComponentScopeRoot *)scopeRoot fromPreviousScopeRoot:(CKComponentScopeRoot *)previousScopeRoot {}
 
+- (void)didBuildMemoizedComponent:(Class)componentClass reusedPreviousSubtree:(BOOL)reused inScopeRoot:(CKComponentScopeRoot *)scopeRoot
+{
+  if (reused) {
+    self.memoizedSubtreesReusedCount++;
+  } else {
+    self.memoizedSubtreesRebuiltCount++;
+  }
+}
+
 - (void)didReceiveStateUpdateFromScopeHandle:(CKComponentScopeHandle *)handle rootIdentifier:(CKComponentScopeRootIdentifier)rootID {
   dispatch_sync(_propertyAccessQueue, ^{
     _events.push_back(DidReceiveStateUpdate{handle, rootID});
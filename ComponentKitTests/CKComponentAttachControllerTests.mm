@@ -149,6 +149,77 @@ struct CKComponentTestAttachResult {
   XCTAssertNil([attachController layoutProviderForScopeIdentifier:scopeIdentifier2]);
 }
 
+- (void)testAttachingWithMountSliceBudgetMountsTheLayoutOverSeveralRunLoopTurns
+{
+  auto const attachController = [CKComponentAttachController new];
+  auto const view = [UIView new];
+  CKComponent *const root = [CKComponent new];
+  CKComponent *const top = [CKComponent new];
+  CKComponent *const bottom = [CKComponent new];
+  auto const layoutProvider =
+  [[CKComponentRootLayoutTestProvider alloc] initWithRootLayout:CKComponentRootLayout {
+    {root, {100, 200}, {{{0, 0}, {top, {100, 100}}}, {{0, 100}, {bottom, {100, 100}}}}}
+  }];
+  auto const spy = [CKAnalyticsListenerSpy new];
+
+  // A budget this small mounts a single component per run loop turn.
+  CKComponentAttachControllerAttachComponentRootLayout(attachController,
+                                                       {
+                                                         .layoutProvider = layoutProvider,
+                                                         .scopeIdentifier = 0x5C09E,
+                                                         .boundsAnimation = {},
+                                                         .view = view,
+                                                         .analyticsListener = spy,
+                                                         .mountSliceBudget = 1e-9,
+                                                       });
+  CKComponentAttachState *attachState = [attachController attachStateForScopeIdentifier:0x5C09E];
+  XCTAssertEqualObjects(attachState.mountedComponents, [NSSet setWithObject:root]);
+  XCTAssertEqual(spy.willMountComponentHitCount, 1);
+  XCTAssertEqual(spy.didMountComponentHitCount, 0);
+
+  NSSet *const allComponents = [NSSet setWithObjects:root, top, bottom, nil];
+  NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+  while (spy.didMountComponentHitCount == 0 && [timeout timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  }
+  XCTAssertEqualObjects(attachState.mountedComponents, allComponents);
+  XCTAssertEqual(spy.didMountComponentHitCount, 1);
+
+  [attachController detachComponentLayoutWithScopeIdentifier:0x5C09E];
+  XCTAssertNil([attachController attachStateForScopeIdentifier:0x5C09E]);
+}
+
+- (void)testDetachingBeforeASlicedMountIsFinishedStopsIt
+{
+  auto const attachController = [CKComponentAttachController new];
+  auto const view = [UIView new];
+  CKComponent *const root = [CKComponent new];
+  CKComponent *const child = [CKComponent newWithView:{[UIView class]} size:{}];
+  auto const layoutProvider =
+  [[CKComponentRootLayoutTestProvider alloc] initWithRootLayout:CKComponentRootLayout {
+    {root, {100, 100}, {{{0, 0}, {child, {100, 100}}}}}
+  }];
+  auto const spy = [CKAnalyticsListenerSpy new];
+
+  CKComponentAttachControllerAttachComponentRootLayout(attachController,
+                                                       {
+                                                         .layoutProvider = layoutProvider,
+                                                         .scopeIdentifier = 0x5C09E,
+                                                         .boundsAnimation = {},
+                                                         .view = view,
+                                                         .analyticsListener = spy,
+                                                         .mountSliceBudget = 1e-9,
+                                                       });
+  [attachController detachComponentLayoutWithScopeIdentifier:0x5C09E];
+  XCTAssertEqual(spy.didMountComponentHitCount, 1, @"Abandoning the mount should end it for the listener");
+  [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+
+  XCTAssertNil([attachController attachStateForScopeIdentifier:0x5C09E]);
+  XCTAssertNil(child.viewContext.view, @"The rest of the layout should never be mounted");
+  XCTAssertEqual(spy.willMountComponentHitCount, 1);
+  XCTAssertEqual(spy.didMountComponentHitCount, 1);
+}
+
 #pragma mark - Helpers
 
 - (CKComponentTestAttachResult)_attachWithAttachController:(CKComponentAttachController *)attachController
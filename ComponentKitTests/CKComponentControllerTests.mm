@@ -10,11 +10,16 @@
 
 #import <XCTest/XCTest.h>
 
+#import <ComponentKit/CKBuildComponent.h>
 #import <ComponentKit/CKComponent.h>
 #import <ComponentKit/CKComponentController.h>
 #import <ComponentKit/CKComponentControllerEvents.h>
 #import <ComponentKit/CKComponentControllerHelper.h>
+#import <ComponentKit/CKComponentInternal.h>
 #import <ComponentKit/CKComponentScope.h>
+#import <ComponentKit/CKComponentScopeHandle.h>
+#import <ComponentKit/CKComponentScopeRoot.h>
+#import <ComponentKit/CKComponentScopeRootFactory.h>
 #import <ComponentKit/CKComponentSubclass.h>
 #import <ComponentKit/CKComponentHostingView.h>
 #import <ComponentKit/CKThreadLocalComponentScope.h>
@@ -32,6 +37,21 @@ using namespace CKComponentControllerHelper;
 @interface CKEmptyComponentController: CKComponentController
 @end
 
+static NSInteger lazyControllerAllocationCount;
+
+@interface CKLazyControllerComponent : CKComponent
+@end
+
+@interface CKLazyControllerComponentController : CKComponentController
+@end
+
+static NSInteger lazyControllerPredicateEvaluationCount;
+static BOOL lazyControllerPredicate(id<CKComponentControllerProtocol> controller)
+{
+  lazyControllerPredicateEvaluationCount++;
+  return [controller isKindOfClass:[CKLazyControllerComponentController class]];
+}
+
 @interface CKComponentControllerTests : CKComponentTestCase
 @end
 
@@ -567,7 +587,120 @@ static CKComponent *componentProvider(id<NSObject> model, id<NSObject>context)
   XCTAssertEqual(controller.calledDidUpdateComponent, 1);
 }
 
+#pragma mark - Lazily created controllers
+
+static CKComponent *lazyControllerComponentProvider(id<NSObject> model, id<NSObject>context)
+{
+  return [CKLazyControllerComponent new];
+}
+
+- (void)testLazyControllerIsNotCreatedUntilAccessed
+{
+  lazyControllerAllocationCount = 0;
+  const auto result = CKBuildComponent(CKComponentScopeRootWithDefaultPredicates(nil, nil), {}, ^{
+    return [CKLazyControllerComponent new];
+  });
+  auto const component = (CKLazyControllerComponent *)result.component;
+
+  XCTAssertEqual(lazyControllerAllocationCount, 0);
+  XCTAssertTrue(component.hasController);
+  XCTAssertNil(component.treeNode.scopeHandle.builtController);
+
+  auto const controller = component.controller;
+  XCTAssertTrue([controller isKindOfClass:[CKLazyControllerComponentController class]]);
+  XCTAssertEqual(component.controller, controller);
+  XCTAssertEqual(lazyControllerAllocationCount, 1);
+}
+
+- (void)testLazyControllerIsCreatedOnMount
+{
+  lazyControllerAllocationCount = 0;
+  CKComponentLifecycleTestHelper *componentLifecycleTestController = [[CKComponentLifecycleTestHelper alloc] initWithComponentProvider:lazyControllerComponentProvider
+                                                                                                                             sizeRangeProvider:nil];
+  const CKComponentLifecycleTestHelperState state = [componentLifecycleTestController prepareForUpdateWithModel:nil
+                                                                                                    constrainedSize:{{0,0}, {100, 100}}
+                                                                                                            context:nil];
+  [componentLifecycleTestController updateWithState:state];
+  XCTAssertEqual(lazyControllerAllocationCount, 0);
+
+  [componentLifecycleTestController attachToView:[UIView new]];
+  XCTAssertEqual(lazyControllerAllocationCount, 1);
+}
+
+- (void)testBuiltLazyControllerIsCarriedOverAndMatchesPredicates
+{
+  lazyControllerAllocationCount = 0;
+  const auto block = ^{
+    return [CKLazyControllerComponent new];
+  };
+  const auto firstResult = CKBuildComponent(CKComponentScopeRootWithPredicates(nil, nil, {}, {&lazyControllerPredicate}), {}, block);
+  XCTAssertTrue([firstResult.scopeRoot componentControllersMatchingPredicate:&lazyControllerPredicate].empty());
+
+  auto const controller = ((CKLazyControllerComponent *)firstResult.component).controller;
+  const auto secondResult = CKBuildComponent(firstResult.scopeRoot, {}, block);
+
+  XCTAssertEqual(((CKLazyControllerComponent *)secondResult.component).controller, controller);
+  XCTAssertEqual(lazyControllerAllocationCount, 1);
+  for (CKComponentScopeRoot *scopeRoot in @[firstResult.scopeRoot, secondResult.scopeRoot]) {
+    const auto controllers = [scopeRoot componentControllersMatchingPredicate:&lazyControllerPredicate];
+    XCTAssertEqual(controllers.size(), 1);
+    XCTAssertEqual(*controllers.begin(), controller);
+  }
+}
+
+- (void)testBuiltLazyControllerIsEvaluatedAgainstPredicatesOnlyOnce
+{
+  lazyControllerPredicateEvaluationCount = 0;
+  const auto block = ^{
+    return [CKLazyControllerComponent new];
+  };
+  const auto firstResult = CKBuildComponent(CKComponentScopeRootWithPredicates(nil, nil, {}, {&lazyControllerPredicate}), {}, block);
+  // Not built yet: nothing to evaluate.
+  [firstResult.scopeRoot enumerateComponentControllersMatchingPredicate:&lazyControllerPredicate
+                                                                  block:^(id<CKComponentControllerProtocol> controller) {}];
+  XCTAssertEqual(lazyControllerPredicateEvaluationCount, 0);
+
+  auto const controller = ((CKLazyControllerComponent *)firstResult.component).controller;
+  XCTAssertEqual([firstResult.scopeRoot componentControllersMatchingPredicate:&lazyControllerPredicate].size(), 1);
+  XCTAssertEqual([firstResult.scopeRoot componentControllersMatchingPredicate:&lazyControllerPredicate].size(), 1);
+  XCTAssertEqual(lazyControllerPredicateEvaluationCount, 1);
+
+  // Both the generation built before the controller and the one after share its match bits.
+  const auto secondResult = CKBuildComponent(firstResult.scopeRoot, {}, block);
+  const auto thirdResult = CKBuildComponent(secondResult.scopeRoot, {}, block);
+  for (CKComponentScopeRoot *scopeRoot in @[secondResult.scopeRoot, thirdResult.scopeRoot]) {
+    const auto controllers = [scopeRoot componentControllersMatchingPredicate:&lazyControllerPredicate];
+    XCTAssertEqual(controllers.size(), 1);
+    XCTAssertEqual(*controllers.begin(), controller);
+  }
+  XCTAssertEqual(lazyControllerPredicateEvaluationCount, 1);
+}
+
 @end
 
 @implementation CKEmptyComponentController
 @end
+
+@implementation CKLazyControllerComponent
++ (instancetype)new
+{
+  CKComponentScope scope(self);
+  return [super newWithView:{[UIView class]} size:{}];
+}
++ (Class<CKComponentControllerProtocol>)controllerClass
+{
+  return [CKLazyControllerComponentController class];
+}
+@end
+
+@implementation CKLazyControllerComponentController
++ (BOOL)shouldBeCreatedLazily
+{
+  return YES;
+}
+- (instancetype)initWithComponent:(CKComponent *)component
+{
+  lazyControllerAllocationCount++;
+  return [super initWithComponent:component];
+}
+@end
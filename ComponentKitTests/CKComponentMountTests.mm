@@ -18,12 +18,41 @@
 #import <ComponentKit/CKLayoutComponent.h>
 #import <ComponentKit/CKMountableHelpers.h>
 #import <ComponentKit/CKMountedObjectForView.h>
+#import <ComponentKit/ComponentViewManager.h>
+#import <ComponentKit/ComponentViewReuseUtilities.h>
 
 #import "CKComponentTestCase.h"
 
 @interface CKComponentMountTests : CKComponentTestCase
 @end
 
+/** Records the components it is told about, in order, prefixed with "will " or "did ". */
+@interface CKMountLayoutListenerRecorder : NSObject <CKMountLayoutListener>
+@property (nonatomic, readonly) NSMutableArray *events;
+@end
+
+@implementation CKMountLayoutListenerRecorder
+
+- (instancetype)init
+{
+  if (self = [super init]) {
+    _events = [NSMutableArray array];
+  }
+  return self;
+}
+
+- (void)willMountComponent:(id<CKMountable>)component
+{
+  [_events addObject:@[@"will", component]];
+}
+
+- (void)didMountComponent:(id<CKMountable>)component
+{
+  [_events addObject:@[@"did", component]];
+}
+
+@end
+
 @interface CKDontMountChildrenComponent : CKLayoutComponent
 
 CK_INIT_UNAVAILABLE;
@@ -110,6 +139,183 @@ CK_LAYOUT_COMPONENT_INIT_UNAVAILABLE;
   XCTAssertNil(b.viewContext.view, @"Should not be mounted");
 }
 
+- (void)testMountingPlanUnmountsComponentsInSubtreesWhoseChildrenAreNotMounted
+{
+  CKComponent *viewComponent = CK::ComponentBuilder()
+                                   .viewClass([UIView class])
+                                   .build();
+  CKComponent *c = [CKDontMountChildrenComponent newWithChild:viewComponent];
+  const RCLayout layout = [c layoutThatFits:{} parentSize:{NAN, NAN}];
+
+  const RCMountPlan plan(layout);
+  XCTAssertEqual(plan.items().size(), 2u);
+  XCTAssertEqual(plan.items()[0].subtreeEnd, 2u);
+  XCTAssertEqual(plan.items()[1].parent, 0u);
+
+  UIView *container = [UIView new];
+  NSSet *previouslyMounted = CKMountComponentLayout(RCLayout {viewComponent, CGSizeZero}, container, nil, nil);
+  XCTAssertNotNil(viewComponent.viewContext.view, @"Didn't create view");
+
+  NSSet *mounted = CKMountComponentLayout(plan, container, previouslyMounted, nil);
+  XCTAssertEqualObjects(mounted, [NSSet setWithObject:c]);
+  XCTAssertNil(viewComponent.viewContext.view, @"Should not be mounted");
+}
+
+- (void)testMountingPlanOnlyMountsComponentsIntersectingMountRect
+{
+  CKComponent *top = CK::ComponentBuilder()
+                         .viewClass([UIView class])
+                         .build();
+  CKComponent *bottom = CK::ComponentBuilder()
+                            .viewClass([UIView class])
+                            .build();
+  CKComponent *root = CK::ComponentBuilder()
+                          .viewClass([UIView class])
+                          .build();
+  const RCLayout layout = {root, {100, 1000},
+    {
+      {{0, 0}, {top, {100, 100}}},
+      {{0, 900}, {bottom, {100, 100}}},
+    }
+  };
+  const RCMountPlan plan(layout);
+  XCTAssertTrue(CGRectEqualToRect(plan.items()[0].subtreeFrame, CGRect {{0, 0}, {100, 1000}}));
+  XCTAssertTrue(CGRectEqualToRect(plan.items()[2].subtreeFrame, CGRect {{0, 900}, {100, 100}}));
+
+  UIView *container = [UIView new];
+  NSSet *mountedAtTop = CKMountComponentLayout(plan, container, nil, nil, nil, {{0, 0}, {100, 200}});
+  XCTAssertEqualObjects(mountedAtTop, ([NSSet setWithObjects:root, top, nil]));
+  XCTAssertNil(bottom.viewContext.view, @"Should not be mounted");
+
+  NSSet *mountedAtBottom = CKMountComponentLayout(plan, container, mountedAtTop, nil, nil, {{0, 800}, {100, 200}});
+  XCTAssertEqualObjects(mountedAtBottom, ([NSSet setWithObjects:root, bottom, nil]));
+  XCTAssertNil(top.viewContext.view, @"Should have been unmounted");
+  XCTAssertNotNil(bottom.viewContext.view, @"Didn't create view");
+
+  CKUnmountComponents(mountedAtBottom);
+}
+
+- (void)testMountingPlanMountsComponentsBesideMountRectSinceOnlyTheVerticalAxisIsCulled
+{
+  CKComponent *firstPage = CK::ComponentBuilder()
+                               .viewClass([UIView class])
+                               .build();
+  CKComponent *lastPage = CK::ComponentBuilder()
+                              .viewClass([UIView class])
+                              .build();
+  // Like a carousel, whose pages are scrolled into view without the mount rect moving.
+  CKComponent *carousel = CK::ComponentBuilder()
+                              .viewClass([UIScrollView class])
+                              .build();
+  CKComponent *root = CK::ComponentBuilder()
+                          .viewClass([UIView class])
+                          .build();
+  const RCLayout layout = {root, {100, 1000},
+    {
+      {{0, 0}, {carousel, {100, 100},
+        {
+          {{0, 0}, {firstPage, {100, 100}}},
+          {{900, 0}, {lastPage, {100, 100}}},
+        }
+      }},
+    }
+  };
+  const RCMountPlan plan(layout);
+
+  UIView *container = [UIView new];
+  NSSet *mounted = CKMountComponentLayout(plan, container, nil, nil, nil, {{0, 0}, {100, 200}});
+  XCTAssertEqualObjects(mounted, ([NSSet setWithObjects:root, carousel, firstPage, lastPage, nil]));
+  XCTAssertNotNil(lastPage.viewContext.view, @"Didn't create view");
+
+  CKUnmountComponents(mounted);
+}
+
+- (void)testMountCursorMountsVisibleComponentsFirstAndUnmountsStaleComponentsWhenFinished
+{
+  CKComponent *top = CK::ComponentBuilder()
+                         .viewClass([UIView class])
+                         .build();
+  CKComponent *bottom = CK::ComponentBuilder()
+                            .viewClass([UIView class])
+                            .build();
+  CKComponent *root = CK::ComponentBuilder()
+                          .viewClass([UIView class])
+                          .build();
+  // Uses a different view class so that its view isn't reused by the new components.
+  CKComponent *stale = CK::ComponentBuilder()
+                           .viewClass([UILabel class])
+                           .build();
+  UIView *container = [UIView new];
+  NSSet *previouslyMounted = CKMountComponentLayout(RCLayout {stale, CGSizeZero}, container, nil, nil);
+
+  const RCLayout layout = {root, {100, 1000},
+    {
+      {{0, 0}, {top, {100, 100}}},
+      {{0, 900}, {bottom, {100, 100}}},
+    }
+  };
+  CKMountLayoutListenerRecorder *const listener = [CKMountLayoutListenerRecorder new];
+  RCMountCursor cursor(std::make_shared<const RCMountPlan>(layout),
+                       container,
+                       previouslyMounted,
+                       nil,
+                       {{0, 800}, {100, 200}},
+                       nullptr,
+                       listener);
+  RCMountTimeHistogram histogram;
+
+  // A zero budget mounts a single item per slice.
+  XCTAssertFalse(cursor.mountWithBudget(0, &histogram));
+  XCTAssertFalse(cursor.mountWithBudget(0, &histogram));
+  XCTAssertNotNil(bottom.viewContext.view, @"Visible component should be mounted first");
+  XCTAssertNil(top.viewContext.view, @"Should not be mounted yet");
+  XCTAssertNotNil(stale.viewContext.view, @"Should stay mounted until the cursor is finished");
+  XCTAssertEqualObjects(cursor.mountedComponents(), ([NSSet setWithObjects:root, bottom, stale, nil]));
+
+  XCTAssertTrue(cursor.mountWithBudget(0, &histogram));
+  XCTAssertNotNil(top.viewContext.view, @"Didn't create view");
+  XCTAssertNil(stale.viewContext.view, @"Should have been unmounted");
+  XCTAssertEqualObjects(cursor.mountedComponents(), ([NSSet setWithObjects:root, top, bottom, nil]));
+
+  NSUInteger slices = 0;
+  for (const auto count : histogram.counts) {
+    slices += count;
+  }
+  XCTAssertEqual(slices, 3u);
+
+  // Each component is announced as it is mounted, and reported as mounted, children first, once the cursor is finished.
+  XCTAssertEqualObjects(listener.events, (@[
+    @[@"will", root], @[@"will", bottom], @[@"will", top],
+    @[@"did", bottom], @[@"did", top], @[@"did", root],
+  ]));
+
+  CKUnmountComponents(cursor.mountedComponents());
+}
+
+- (void)testMountTraceRecordsViewCreationAndAttributeApplicationByComponentClass
+{
+  CKComponent *c = CK::ComponentBuilder()
+                       .viewClass([UILabel class])
+                       .attribute(@selector(setText:), @"Hello")
+                       .build();
+  CK::Component::MountAnalyticsContext mountAnalyticsContext;
+  mountAnalyticsContext.trace = std::make_shared<CK::Component::MountTrace>();
+
+  UIView *container = [UIView new];
+  NSSet *mounted = CKMountLayout(RCLayout {c, {10, 10}}, container, nil, nil, &mountAnalyticsContext, nil);
+
+  const auto counters = mountAnalyticsContext.trace->countersForComponentClass([c class]);
+  XCTAssertTrue(counters != nullptr);
+  XCTAssertEqual((*counters)[CK::Component::MountTrace::viewCreation].count, 1u);
+  XCTAssertEqual((*counters)[CK::Component::MountTrace::attributeApplication].count, 1u);
+
+  NSDictionary *const json = [NSJSONSerialization JSONObjectWithData:mountAnalyticsContext.trace->JSONData() options:0 error:nil];
+  XCTAssertEqual([json[@"viewKeys"] count], 1u);
+  XCTAssertEqualObjects(json[@"viewKeys"][0][@"componentClass"], NSStringFromClass([c class]));
+
+  CKUnmountComponents(mounted);
+}
+
 - (void)testPerformMount
 {
   const auto viewConfig = CKComponentViewConfiguration {
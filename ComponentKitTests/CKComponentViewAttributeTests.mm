@@ -11,10 +11,16 @@
 #import <UIKit/UIKit.h>
 #import <XCTest/XCTest.h>
 
+#import <algorithm>
+#import <memory>
+#import <vector>
+
 #import <ComponentKitTestHelpers/CKComponentLifecycleTestHelper.h>
 
 #import <ComponentKit/CKComponent.h>
 #import <ComponentKit/CKComponentSubclass.h>
+#import <ComponentKit/CKComponentViewAttribute.h>
+#import <ComponentKit/ComponentViewManager.h>
 
 #import "CKComponentTestCase.h"
 
@@ -321,6 +327,88 @@
   XCTAssertEqual(updateCount, 0u, @"Nothing should be updated");
 }
 
+#pragma mark - Mount Preparation
+
+- (void)testThatPreparedAttributeDiffIsOnlyReplayedOnViewShowingAttributesItWasPreparedAgainst
+{
+  NSMutableArray<NSString *> *calls = [NSMutableArray array];
+  const CKComponentViewAttribute attribute("prepared", ^(UIView *view, id value){
+    [calls addObject:[NSString stringWithFormat:@"apply %@", value]];
+  }, ^(UIView *view, id value){
+    [calls addObject:[NSString stringWithFormat:@"unapply %@", value]];
+  });
+  const CKViewConfiguration first {[UIView class], {{attribute, @1}}};
+  const CKViewConfiguration second {[UIView class], {{attribute, @2}}};
+  const CKViewConfiguration third {[UIView class], {{attribute, @3}}};
+  CK::Component::MountPreparation preparation;
+  preparation.prepare(first, second);
+
+  UIView *view = [UIView new];
+  CK::Component::AttributeApplicator::apply(view, first);
+  CK::Component::AttributeApplicator::apply(view, second, &preparation);
+  XCTAssertEqualObjects(calls, (@[@"apply 1", @"unapply 1", @"apply 2"]));
+
+  // The view shows `third` rather than `first`, so the prepared diff doesn't apply and attributes are diffed as usual.
+  [calls removeAllObjects];
+  UIView *otherView = [UIView new];
+  CK::Component::AttributeApplicator::apply(otherView, third);
+  CK::Component::AttributeApplicator::apply(otherView, second, &preparation);
+  XCTAssertEqualObjects(calls, (@[@"apply 3", @"unapply 3", @"apply 2"]));
+}
+
+#pragma mark - Attribute Value Map
+
+- (void)testThatAttributeValueMapKeepsFirstValueAndIteratesInInternedIdentifierOrder
+{
+  CKViewComponentAttributeValueMap map {
+    {@selector(setTag:), @1},
+    {@selector(setAlpha:), @0.5},
+    {@selector(setTag:), @2},
+  };
+  XCTAssertFalse(map.insert({@selector(setAlpha:), @1}).second);
+  XCTAssertTrue(map.insert({@selector(setHidden:), @YES}).second);
+
+  XCTAssertEqual(map.size(), 3);
+  XCTAssertEqualObjects(map.find(@selector(setTag:))->second, @1);
+  XCTAssertEqualObjects(map[@selector(setAlpha:)], @0.5);
+  XCTAssertTrue(map.find(@selector(setOpaque:)) == map.end());
+  XCTAssertTrue(std::is_sorted(map.begin(), map.end(), [](const auto &lhs, const auto &rhs){
+    return lhs.first < rhs.first;
+  }));
+}
+
+#pragma mark - Persistent Attribute Shape
+
+- (void)testThatPersistentAttributeShapeDependsOnlyOnIdentifiersOfAttributesWithoutUnapplicator
+{
+  const CKComponentViewAttribute unapplicable("unapplicable", ^(id view, id value){}, ^(id view, id value){});
+  const CK::Component::PersistentAttributeShape shape({{@selector(setTag:), @1}, {@selector(setAlpha:), @0.5}});
+
+  XCTAssertTrue(shape == CK::Component::PersistentAttributeShape({{@selector(setAlpha:), @1}, {@selector(setTag:), @2}}));
+  XCTAssertTrue(shape == CK::Component::PersistentAttributeShape({{@selector(setTag:), @1}, {@selector(setAlpha:), @0.5}, {unapplicable, @YES}}));
+  XCTAssertFalse(shape == CK::Component::PersistentAttributeShape({{@selector(setTag:), @1}}));
+  XCTAssertFalse(shape == CK::Component::PersistentAttributeShape({{@selector(setTag:), @1}, {@selector(setHidden:), @NO}}));
+  XCTAssertFalse(shape == CK::Component::PersistentAttributeShape({{@selector(setTag:), @1}, {@selector(setAlpha:), @0.5}, {@selector(setHidden:), @NO}}));
+}
+
+- (void)testThatPersistentAttributeShapesAreInternedConsistentlyAcrossThreads
+{
+  const NSUInteger attributeCount = 600;
+  std::vector<std::unique_ptr<CK::Component::PersistentAttributeShape>> shapes(attributeCount);
+  auto const shapesData = shapes.data();
+  // Enough distinct shapes to grow the interning table while it is being read from other threads.
+  dispatch_apply(attributeCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+    const CKComponentViewAttribute attribute(std::string("attribute") + std::to_string(i), ^(id view, id value){});
+    shapesData[i].reset(new CK::Component::PersistentAttributeShape({{attribute, @1}, {@selector(setTag:), @1}}));
+  });
+
+  for (NSUInteger i = 0; i < attributeCount; i++) {
+    const CKComponentViewAttribute attribute(std::string("attribute") + std::to_string(i), ^(id view, id value){});
+    XCTAssertTrue(*shapes[i] == CK::Component::PersistentAttributeShape({{@selector(setTag:), @2}, {attribute, @2}}));
+    XCTAssertFalse(*shapes[i] == *shapes[(i + 1) % attributeCount]);
+  }
+}
+
 @end
 
 @implementation CKSetterCounterView
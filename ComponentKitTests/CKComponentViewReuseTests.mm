@@ -18,6 +18,7 @@
 #import <ComponentKit/CKCompositeComponent.h>
 #import <ComponentKit/ComponentViewManager.h>
 #import <ComponentKit/ComponentViewReuseUtilities.h>
+#import <RenderCore/RCDeferredRelease.h>
 
 #import "CKComponentTestCase.h"
 
@@ -244,6 +245,117 @@ static UIView *viewFactory()
   // even though its parent was unhidden and it was hidden.
 }
 
+- (void)testThatViewsIdleInOneContainerAreReusedByAnotherThroughTheGlobalPool
+{
+  auto &globalPool = GlobalViewReusePool::sharedPool();
+  globalPool.setLimits(4, 16);
+
+  CKComponent *component = CK::ComponentBuilder()
+                               .viewClass([UIView class])
+                               .build();
+  CKComponent *otherComponent = CK::ComponentBuilder()
+                                    .viewClass([UIImageView class])
+                                    .build();
+  UIView *firstContainer = [[UIView alloc] init];
+  CK::Component::ViewReuseUtilities::mountingInRootView(firstContainer);
+  UIView *createdView;
+  {
+    ViewManager m(firstContainer);
+    createdView = m.viewForConfiguration([component class], [component viewConfiguration]);
+  }
+  // The view has to go unused for two mounts of its container before it is parked.
+  for (int i = 0; i < 2; i++) {
+    ViewManager m(firstContainer);
+    (void)m.viewForConfiguration([otherComponent class], [otherComponent viewConfiguration]);
+  }
+  XCTAssertNil(createdView.superview, @"Expected idle view to be parked");
+  XCTAssertEqual(globalPool.count(), 1u);
+
+  UIView *secondContainer = [[UIView alloc] init];
+  CK::Component::ViewReuseUtilities::mountingInRootView(secondContainer);
+  MountAnalyticsContext mountAnalyticsContext;
+  {
+    ViewManager m(secondContainer, &mountAnalyticsContext);
+    XCTAssertTrue(createdView == m.viewForConfiguration([component class], [component viewConfiguration]),
+                  @"Expected to receive the view parked by the other container");
+  }
+  XCTAssertTrue(createdView.superview == secondContainer);
+  XCTAssertFalse(createdView.hidden);
+  XCTAssertEqual(mountAnalyticsContext.globalViewReuses, 1u);
+  XCTAssertEqual(mountAnalyticsContext.viewAllocations, 0u);
+  XCTAssertEqual(globalPool.count(), 0u);
+
+  globalPool.setLimits(0, 0);
+}
+
+- (void)testThatViewsEvictedFromTheGlobalPoolAreReleasedWhenTheOutermostTransactionEnds
+{
+  auto &globalPool = GlobalViewReusePool::sharedPool();
+  globalPool.setLimits(4, 16);
+
+  CKComponent *component = CK::ComponentBuilder()
+                               .viewClass([UIView class])
+                               .build();
+  CKComponent *otherComponent = CK::ComponentBuilder()
+                                    .viewClass([UIImageView class])
+                                    .build();
+  UIView *container = [[UIView alloc] init];
+  CK::Component::ViewReuseUtilities::mountingInRootView(container);
+  __weak UIView *weakView;
+  @autoreleasepool {
+    ViewManager m(container);
+    weakView = m.viewForConfiguration([component class], [component viewConfiguration]);
+  }
+  for (int i = 0; i < 2; i++) {
+    @autoreleasepool {
+      ViewManager m(container);
+      (void)m.viewForConfiguration([otherComponent class], [otherComponent viewConfiguration]);
+    }
+  }
+  XCTAssertEqual(globalPool.count(), 1u);
+
+  {
+    const RCDeferredReleaseTransaction transaction;
+    globalPool.setLimits(0, 0);
+    XCTAssertEqual(globalPool.count(), 0u);
+    XCTAssertNotNil(weakView, @"Expected the evicted view to be kept until the transaction ends");
+  }
+  XCTAssertNil(weakView, @"Expected the evicted view to be released with the batch");
+}
+
+- (void)testThatPrewarmingCreatesAsManyViewsAsAContainerNeededForTheNextContainer
+{
+  auto &globalPool = GlobalViewReusePool::sharedPool();
+  globalPool.setLimits(4, 16);
+
+  CKComponent *component = CK::ComponentBuilder()
+                               .viewClass([UIView class])
+                               .build();
+  UIView *firstContainer = [[UIView alloc] init];
+  CK::Component::ViewReuseUtilities::mountingInRootView(firstContainer);
+  {
+    ViewManager m(firstContainer);
+    (void)m.viewForConfiguration([component class], [component viewConfiguration]);
+    (void)m.viewForConfiguration([component class], [component viewConfiguration]);
+  }
+
+  XCTAssertFalse(globalPool.prewarm(INFINITY), @"Expected prewarming to finish within an unlimited budget");
+  XCTAssertEqual(globalPool.count(), 2u);
+
+  UIView *secondContainer = [[UIView alloc] init];
+  CK::Component::ViewReuseUtilities::mountingInRootView(secondContainer);
+  MountAnalyticsContext mountAnalyticsContext;
+  {
+    ViewManager m(secondContainer, &mountAnalyticsContext);
+    (void)m.viewForConfiguration([component class], [component viewConfiguration]);
+    (void)m.viewForConfiguration([component class], [component viewConfiguration]);
+  }
+  XCTAssertEqual(mountAnalyticsContext.viewAllocations, 0u);
+  XCTAssertEqual(mountAnalyticsContext.globalViewReuses, 2u);
+
+  globalPool.setLimits(0, 0);
+}
+
 - (void)testThatComponentThatInjectsAnIntermediateViewNotControlledByComponentsDoesNotBreakViewReuseForItsSubviews
 {
   UIView *rootView = [[UIView alloc] init];
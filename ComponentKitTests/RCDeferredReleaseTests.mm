@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <UIKit/UIKit.h>
+
+#import <RenderCore/RCDeferredRelease.h>
+
+@interface RCDeferredReleaseTests : XCTestCase
+@end
+
+@implementation RCDeferredReleaseTests
+
+- (void)testThatViewsAreReleasedOnTheMainThreadWhenTheOutermostTransactionEnds
+{
+  __weak UIView *weakView;
+  {
+    const RCDeferredReleaseTransaction outerTransaction;
+    {
+      const RCDeferredReleaseTransaction innerTransaction;
+      @autoreleasepool {
+        UIView *view = [UIView new];
+        weakView = view;
+        RCDeferRelease(view);
+      }
+    }
+    XCTAssertNotNil(weakView, @"Expected the view to be kept until the outermost transaction ends");
+  }
+  XCTAssertNil(weakView, @"Expected the view to be released on the main thread with the batch");
+}
+
+- (void)testThatDeletionsAreBatchedAndRunInTheBackground
+{
+  const auto batchesBefore = RCGetDeferredReleaseStatistics().batches;
+  XCTestExpectation *const expectation = [self expectationWithDescription:@"Deleted"];
+  {
+    const RCDeferredReleaseTransaction transaction;
+    RCDeferDelete((__bridge_retained void *)expectation, [](void *target) {
+      XCTestExpectation *const e = (__bridge_transfer XCTestExpectation *)target;
+      XCTAssertFalse([NSThread isMainThread]);
+      [e fulfill];
+    });
+  }
+  XCTAssertEqual(RCGetDeferredReleaseStatistics().batches, batchesBefore + 1);
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+@end
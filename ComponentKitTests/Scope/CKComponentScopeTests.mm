@@ -19,6 +19,7 @@
 #import <ComponentKit/CKComponentProtocol.h>
 #import <ComponentKit/CKComponentControllerProtocol.h>
 #import <ComponentKit/CKComponentInternal.h>
+#import <ComponentKit/CKComponentKey.h>
 #import <ComponentKit/CKRenderComponent.h>
 #import <ComponentKit/CKRootTreeNode.h>
 #import <ComponentKit/CKThreadLocalComponentScope.h>
@@ -134,6 +135,35 @@
   XCTAssertEqual(CKThreadLocalComponentScope::currentScope(), nullptr);
 }
 
+- (void)testThreadLocalComponentScopeKeysAreScopedToTheirFrame
+{
+  CKComponentScopeRoot *root = CKComponentScopeRootWithDefaultPredicates(nil, nil);
+  CKThreadLocalComponentScope threadScope(root, {});
+  {
+    CKComponentKey key(@"foo");
+    XCTAssertTrue(threadScope.stack.keys() == std::vector<id<NSObject>>{@"foo"});
+    {
+      CKComponentScope scope([CKCompositeComponent class]);
+      XCTAssertTrue(threadScope.stack.keys().empty());
+    }
+    XCTAssertTrue(threadScope.stack.keys() == std::vector<id<NSObject>>{@"foo"});
+  }
+  XCTAssertTrue(threadScope.stack.keys().empty());
+}
+
+- (void)testThreadLocalComponentScopeReusesFrameStorageAcrossBuilds
+{
+  const std::vector<id<NSObject>> *rootKeys;
+  {
+    CKThreadLocalComponentScope threadScope(CKComponentScopeRootWithDefaultPredicates(nil, nil), {});
+    rootKeys = &threadScope.stack.keys();
+  }
+  {
+    CKThreadLocalComponentScope threadScope(CKComponentScopeRootWithDefaultPredicates(nil, nil), {});
+    XCTAssertEqual(&threadScope.stack.keys(), rootKeys);
+  }
+}
+
 #pragma mark - Component Scope Frame
 
 - (void)testComponentScopeFrameIsPoppedWhenComponentScopeCloses
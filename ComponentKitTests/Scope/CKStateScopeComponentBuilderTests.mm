@@ -22,6 +22,7 @@
 #import <ComponentKit/CKComponentScopeRootFactory.h>
 #import <ComponentKit/CKRootTreeNode.h>
 #import <ComponentKit/CKThreadLocalComponentScope.h>
+#import <ComponentKitTestHelpers/CKAnalyticsListenerSpy.h>
 
 #import "CKStateExposingComponent.h"
 
@@ -47,6 +48,35 @@
 - (std::vector<CKComponentAnimation>)animationsOnInitialMount { return {}; }
 @end
 
+@interface CKMemoizedComponent : CKCompositeComponent
++ (instancetype)newWithProps:(id)props childBuildCount:(NSInteger *)childBuildCount;
+@end
+
+@implementation CKMemoizedComponent
++ (instancetype)newWithProps:(id)props childBuildCount:(NSInteger *)childBuildCount
+{
+  CKComponentScope scope(self);
+  return [super newWithView:{} props:props childProvider:^{
+    (*childBuildCount)++;
+    return [CKStateExposingComponent new];
+  }];
+}
+@end
+
+static NSInteger componentPredicateEvaluationCount;
+static BOOL countingComponentPredicate(id<CKComponentProtocol> component)
+{
+  componentPredicateEvaluationCount++;
+  return YES;
+}
+
+static NSInteger controllerPredicateEvaluationCount;
+static BOOL countingControllerPredicate(id<CKComponentControllerProtocol> controller)
+{
+  controllerPredicateEvaluationCount++;
+  return YES;
+}
+
 #pragma mark - Tests
 
 @interface CKStateScopeComponentBuilderTests : XCTestCase
@@ -149,4 +179,133 @@
   XCTAssertNil(outerComponent.uniqueIdentifier);
 }
 
+#pragma mark - Memoized Composite Components
+
+- (void)testMemoizedChildIsReusedWhenPropsAreEqual
+{
+  auto const spy = [CKAnalyticsListenerSpy new];
+  NSInteger __block childBuildCount = 0;
+  const auto firstResult = CKBuildComponent(CKComponentScopeRootWithDefaultPredicates(nil, spy), {}, ^{
+    return [CKMemoizedComponent newWithProps:@"props" childBuildCount:&childBuildCount];
+  });
+  const auto secondResult = CKBuildComponent(firstResult.scopeRoot, {}, ^{
+    return [CKMemoizedComponent newWithProps:@"props" childBuildCount:&childBuildCount];
+  });
+
+  XCTAssertEqual(childBuildCount, 1);
+  XCTAssertEqual(((CKMemoizedComponent *)secondResult.component).child, ((CKMemoizedComponent *)firstResult.component).child);
+  XCTAssertEqual(spy.memoizedSubtreesRebuiltCount, 1);
+  XCTAssertEqual(spy.memoizedSubtreesReusedCount, 1);
+}
+
+- (void)testMemoizedChildIsRebuiltWhenPropsChange
+{
+  auto const spy = [CKAnalyticsListenerSpy new];
+  NSInteger __block childBuildCount = 0;
+  const auto firstResult = CKBuildComponent(CKComponentScopeRootWithDefaultPredicates(nil, spy), {}, ^{
+    return [CKMemoizedComponent newWithProps:@"props" childBuildCount:&childBuildCount];
+  });
+  (void)CKBuildComponent(firstResult.scopeRoot, {}, ^{
+    return [CKMemoizedComponent newWithProps:@"other props" childBuildCount:&childBuildCount];
+  });
+
+  XCTAssertEqual(childBuildCount, 2);
+  XCTAssertEqual(spy.memoizedSubtreesRebuiltCount, 2);
+  XCTAssertEqual(spy.memoizedSubtreesReusedCount, 0);
+}
+
+- (void)testMemoizedChildIsRebuiltWhenItHasAStateUpdate
+{
+  NSInteger __block childBuildCount = 0;
+  const auto firstResult = CKBuildComponent(CKComponentScopeRootWithDefaultPredicates(nil, nil), {}, ^{
+    return [CKMemoizedComponent newWithProps:@"props" childBuildCount:&childBuildCount];
+  });
+
+  auto const child = (CKStateExposingComponent *)((CKMemoizedComponent *)firstResult.component).child;
+  CKComponentStateUpdateMap stateUpdates;
+  stateUpdates[child.treeNode.scopeHandle].push_back(^(id){
+    return @42;
+  });
+  const auto secondResult = CKBuildComponent(firstResult.scopeRoot, stateUpdates, ^{
+    return [CKMemoizedComponent newWithProps:@"props" childBuildCount:&childBuildCount];
+  });
+
+  XCTAssertEqual(childBuildCount, 2);
+  XCTAssertEqualObjects(((CKStateExposingComponent *)((CKMemoizedComponent *)secondResult.component).child).state, @42);
+}
+
+- (void)testStateOfReusedMemoizedChildIsPreservedInTheNextGeneration
+{
+  NSInteger __block childBuildCount = 0;
+  const auto firstResult = CKBuildComponent(CKComponentScopeRootWithDefaultPredicates(nil, nil), {}, ^{
+    return [CKMemoizedComponent newWithProps:@"props" childBuildCount:&childBuildCount];
+  });
+  auto const firstChild = (CKStateExposingComponent *)((CKMemoizedComponent *)firstResult.component).child;
+  CKComponentStateUpdateMap stateUpdates;
+  stateUpdates[firstChild.treeNode.scopeHandle].push_back(^(id){
+    return @42;
+  });
+  const auto secondResult = CKBuildComponent(firstResult.scopeRoot, stateUpdates, ^{
+    return [CKMemoizedComponent newWithProps:@"props" childBuildCount:&childBuildCount];
+  });
+  // Reused: its state lives on in the scope tree of this generation only if the subtree was carried over.
+  const auto thirdResult = CKBuildComponent(secondResult.scopeRoot, {}, ^{
+    return [CKMemoizedComponent newWithProps:@"props" childBuildCount:&childBuildCount];
+  });
+  const auto fourthResult = CKBuildComponent(thirdResult.scopeRoot, {}, ^{
+    return [CKMemoizedComponent newWithProps:@"other props" childBuildCount:&childBuildCount];
+  });
+
+  auto const secondChild = (CKStateExposingComponent *)((CKMemoizedComponent *)secondResult.component).child;
+  auto const thirdChild = (CKStateExposingComponent *)((CKMemoizedComponent *)thirdResult.component).child;
+  auto const fourthChild = (CKStateExposingComponent *)((CKMemoizedComponent *)fourthResult.component).child;
+  XCTAssertEqual(childBuildCount, 3);
+  XCTAssertEqual(thirdChild, secondChild);
+  XCTAssertEqualObjects(thirdChild.state, @42);
+  XCTAssertNotEqual(fourthChild, thirdChild);
+  XCTAssertEqualObjects(fourthChild.state, @42);
+  XCTAssertEqual(fourthChild.treeNode.nodeIdentifier, firstChild.treeNode.nodeIdentifier);
+}
+
+#pragma mark - Predicate Matches
+
+- (void)testControllerPredicatesAreNotReevaluatedForControllersCarriedOverToTheNextGeneration
+{
+  controllerPredicateEvaluationCount = 0;
+  auto const block = ^{
+    CKComponentScope scope([CKMonkeyComponent class]);
+    return [CKMonkeyComponent new];
+  };
+  const auto firstResult = CKBuildComponent(CKComponentScopeRootWithPredicates(nil, nil, {}, {&countingControllerPredicate}), {}, block);
+  const auto secondResult = CKBuildComponent(firstResult.scopeRoot, {}, block);
+
+  XCTAssertEqual(controllerPredicateEvaluationCount, 1);
+  NSInteger matchingControllersCount = 0;
+  for (id<CKComponentControllerProtocol> controller : [secondResult.scopeRoot componentControllersMatchingPredicate:&countingControllerPredicate]) {
+    XCTAssertTrue([controller isKindOfClass:[CKMonkeyComponentController class]]);
+    matchingControllersCount++;
+  }
+  XCTAssertEqual(matchingControllersCount, 1);
+}
+
+- (void)testComponentPredicatesAreNotReevaluatedForReusedComponents
+{
+  componentPredicateEvaluationCount = 0;
+  NSInteger __block childBuildCount = 0;
+  auto const block = ^{
+    return [CKMemoizedComponent newWithProps:@"props" childBuildCount:&childBuildCount];
+  };
+  const auto firstResult = CKBuildComponent(CKComponentScopeRootWithPredicates(nil, nil, {&countingComponentPredicate}, {}), {}, block);
+  XCTAssertEqual(componentPredicateEvaluationCount, 2);
+  const auto secondResult = CKBuildComponent(firstResult.scopeRoot, {}, block);
+
+  // Only the new memoized component is evaluated; its reused child replays the match from the previous generation.
+  XCTAssertEqual(componentPredicateEvaluationCount, 3);
+  NSMutableSet *matchingComponents = [NSMutableSet set];
+  for (id<CKComponentProtocol> component : [secondResult.scopeRoot componentsMatchingPredicate:&countingComponentPredicate]) {
+    [matchingComponents addObject:component];
+  }
+  XCTAssertEqualObjects(matchingComponents, ([NSSet setWithObjects:secondResult.component, ((CKMemoizedComponent *)secondResult.component).child, nil]));
+}
+
 @end
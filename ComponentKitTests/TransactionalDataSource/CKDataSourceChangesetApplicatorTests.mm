@@ -361,11 +361,23 @@ fromPreviousScopeRoot:(CKComponentScopeRoot *)previousScopeRoot
 
 }
 
+- (void)didBuildMemoizedComponent:(Class)componentClass
+            reusedPreviousSubtree:(BOOL)reused
+                      inScopeRoot:(CKComponentScopeRoot *)scopeRoot
+{
+
+}
+
 - (BOOL)shouldCollectMountInformationForRootComponent:(CKComponent *)component
 {
   return NO;
 }
 
+- (BOOL)shouldCollectMountTraceForRootComponent:(CKComponent *)component
+{
+  return NO;
+}
+
 - (id<CKSystraceListener>)systraceListener
 {
   return nil;
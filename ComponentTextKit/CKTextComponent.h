@@ -46,4 +46,45 @@ struct CKTextComponentOptions
 
 @end
 
+struct CKTextComponentRendererCacheStatistics {
+  /** Estimated size of the renderers currently cached. */
+  NSUInteger currentBytes;
+  /** Highest estimated size the cached renderers ever reached. */
+  NSUInteger peakBytes;
+  /** Renderers that only repainted the layout of a cached renderer because just the colors of their text changed. */
+  NSUInteger repaints;
+};
+
+/** How much memory the renderers cached for drawing text components are estimated to hold. */
+CKTextComponentRendererCacheStatistics CKTextComponentGetRendererCacheStatistics();
+
+/**
+ Caps the estimated size of the renderers cached for drawing text components, 4MB by default. Least recently used
+ renderers are evicted right away if they're over the new limit.
+ */
+void CKTextComponentSetRendererCacheByteLimit(NSUInteger byteLimit);
+
+struct CKTextComponentMeasurementCacheStatistics {
+  NSUInteger hits;
+  NSUInteger misses;
+  /**
+   Hits for a width other than the one the text was measured at, because its lines break the same way at both: each is
+   a TextKit layout avoided.
+   */
+  NSUInteger rangeHits;
+  /** Misses for long text that were measured by laying out its paragraphs concurrently. */
+  NSUInteger paragraphLayouts;
+};
+
+/** Hits and misses of the cache that answers text size queries during layout. */
+CKTextComponentMeasurementCacheStatistics CKTextComponentGetMeasurementCacheStatistics();
+
+/**
+ Lets text of a couple of thousand characters or more, such as articles, be measured by laying out runs of its
+ paragraphs concurrently in separate TextKit stacks instead of all of it on one thread. Sizes are the same either way:
+ text that is truncated, limited in lines, or could otherwise lay out differently is still measured in one stack, and
+ drawing and hit-testing always use one. Off by default.
+ */
+void CKTextComponentSetParallelParagraphLayoutEnabled(BOOL enabled);
+
 #endif
@@ -10,11 +10,14 @@
 
 #import "CKTextComponent.h"
 
+#import <atomic>
 #import <memory>
+#import <mutex>
 #import <vector>
 
 #import <ComponentKit/CKComponentInternal.h>
 
+#import <ComponentTextKit/CKTextKitMeasurementCache.h>
 #import <ComponentTextKit/CKTextKitRenderer.h>
 #import <ComponentTextKit/CKTextKitRendererCache.h>
 
@@ -26,17 +29,32 @@
 
 static CK::TextKit::Renderer::Cache *sharedRendererCache()
 {
-  // This cache is sized arbitrarily
-  static CK::TextKit::Renderer::Cache *__rendererCache (new CK::TextKit::Renderer::Cache("CKTextComponentRendererCache", 500, 0.2));
+  // Renderers are weighed by their estimated size in bytes, so a long post weighs more than a button label. 4MB holds
+  // around 500 renderers of typical feed text.
+  static CK::TextKit::Renderer::Cache *__rendererCache (new CK::TextKit::Renderer::Cache("CKTextComponentRendererCache", 4 * 1024 * 1024, 0.2));
   return __rendererCache;
 }
 
+/**
+ Renderers by the layout attributes of their text, so that text that only changes color, such as a counter being
+ highlighted, can be repainted over an existing layout. Holds renderers the main cache may already have evicted.
+ */
+static CK::TextKit::Renderer::Cache *sharedLayoutCache()
+{
+  static CK::TextKit::Renderer::Cache *__layoutCache (new CK::TextKit::Renderer::Cache("CKTextComponentLayoutCache", 1024 * 1024, 0.2));
+  return __layoutCache;
+}
+
+static std::atomic<NSUInteger> repaintedRendererCount;
+
 /**
  The concept here is that neither the component nor layout should ever have a strong reference to the renderer object.
  This is to reduce memory load when loading thousands and thousands of text components into memory at once.  Instead
  we maintain a LRU renderer cache that is queried via stack-allocated keys.
  */
-static CKTextKitRenderer *rendererForAttributes(CKTextKitAttributes &attributes, CGSize constrainedSize)
+static CKTextKitRenderer *rendererForAttributes(CKTextKitAttributes &attributes,
+                                                const CKTextKitAttributes &layoutAttributes,
+                                                CGSize constrainedSize)
 {
   CK::TextKit::Renderer::Cache *cache = sharedRendererCache();
   const CK::TextKit::Renderer::Key key {
@@ -47,19 +65,84 @@ static CKTextKitRenderer *rendererForAttributes(CKTextKitAttributes &attributes,
   CKTextKitRenderer *renderer = cache->objectForKey(key);
 
   if (!renderer) {
-    renderer =
-    [[CKTextKitRenderer alloc]
-     initWithTextKitAttributes:attributes
-     constrainedSize:constrainedSize];
-    cache->cacheObject(key, renderer, 1);
+    CK::TextKit::Renderer::Cache *layoutCache = sharedLayoutCache();
+    const CK::TextKit::Renderer::Key layoutKey {
+      layoutAttributes,
+      constrainedSize
+    };
+    CKTextKitRenderer *layoutRenderer = layoutCache->objectForKey(layoutKey);
+    if (layoutRenderer) {
+      renderer = [[CKTextKitRenderer alloc] initWithTextKitAttributes:attributes repaintingRenderer:layoutRenderer];
+      if (renderer) {
+        repaintedRendererCount++;
+      }
+    }
+    if (!renderer) {
+      renderer =
+      [[CKTextKitRenderer alloc]
+       initWithTextKitAttributes:attributes
+       constrainedSize:constrainedSize];
+      layoutCache->cacheObject(layoutKey, renderer, renderer.estimatedByteCost);
+    }
+    cache->cacheObject(key, renderer, renderer.estimatedByteCost);
   }
 
   return renderer;
 }
 
+CKTextComponentRendererCacheStatistics CKTextComponentGetRendererCacheStatistics()
+{
+  CK::TextKit::Renderer::Cache *cache = sharedRendererCache();
+  return {
+    .currentBytes = cache->totalCost(),
+    .peakBytes = cache->peakCost(),
+    .repaints = repaintedRendererCount,
+  };
+}
+
+void CKTextComponentSetRendererCacheByteLimit(NSUInteger byteLimit)
+{
+  sharedRendererCache()->setMaxCost(byteLimit);
+}
+
+static CK::TextKit::Measurement::Cache *sharedMeasurementCache()
+{
+  // Entries only hold a few numbers, so this can be much larger than the renderer cache.
+  static CK::TextKit::Measurement::Cache *__measurementCache (new CK::TextKit::Measurement::Cache("CKTextComponentMeasurementCache", 5000, 0.2));
+  return __measurementCache;
+}
+
+/**
+ Layout only needs the size of the text, which is answered from the measurement cache so that computing layouts never
+ keeps renderers alive. The renderer is only built when the component is mounted and its text is about to be drawn.
+ */
+static CK::TextKit::Measurement::Metrics metricsForAttributes(const CKTextKitAttributes &attributes, CGSize constrainedSize)
+{
+  return sharedMeasurementCache()->metrics(attributes, constrainedSize);
+}
+
+CKTextComponentMeasurementCacheStatistics CKTextComponentGetMeasurementCacheStatistics()
+{
+  const CK::TextKit::Measurement::Statistics statistics = sharedMeasurementCache()->getStatistics();
+  return {
+    .hits = statistics.hits,
+    .misses = statistics.misses,
+    .rangeHits = statistics.rangeHits,
+    .paragraphLayouts = statistics.paragraphLayouts,
+  };
+}
+
+void CKTextComponentSetParallelParagraphLayoutEnabled(BOOL enabled)
+{
+  sharedMeasurementCache()->setParagraphLayoutEnabled(enabled);
+}
+
 @implementation CKTextComponent
 {
   CKTextKitAttributes _attributes;
+  /** Computed at the first layout or mount; most components are built many more times than they are laid out. */
+  CKTextKitAttributes _layoutAttributes;
+  std::once_flag _layoutAttributesOnce;
   CKTextComponentAccessibilityContext _accessibilityContext;
 }
 
@@ -87,14 +170,23 @@ static CKTextKitRenderer *rendererForAttributes(CKTextKitAttributes &attributes,
   return c;
 }
 
+- (const CKTextKitAttributes &)layoutAttributes
+{
+  // Layout may be computed off the main thread, and mounting follows on the main thread.
+  std::call_once(_layoutAttributesOnce, [&] {
+    self->_layoutAttributes = self->_attributes.layoutAttributes();
+  });
+  return _layoutAttributes;
+}
+
 - (RCLayout)computeLayoutThatFits:(CKSizeRange)constrainedSize
 {
-  const CKTextKitRenderer *renderer = rendererForAttributes(_attributes, constrainedSize.max);
+  const CK::TextKit::Measurement::Metrics metrics = metricsForAttributes([self layoutAttributes], constrainedSize.max);
   return {
     self,
     constrainedSize.clamp({
-      CKCeilPixelValue(renderer.size.width),
-      CKCeilPixelValue(renderer.size.height)
+      CKCeilPixelValue(metrics.size.width),
+      CKCeilPixelValue(metrics.size.height)
     }),
     {}
   };
@@ -108,7 +200,7 @@ static CKTextKitRenderer *rendererForAttributes(CKTextKitAttributes &attributes,
                                                        layout:layout
                                              supercomponent:supercomponent];
   CKTextComponentView *view = (CKTextComponentView *)result.contextForChildren.viewManager->view;
-  CKTextKitRenderer *renderer = rendererForAttributes(_attributes, layout.size);
+  CKTextKitRenderer *renderer = rendererForAttributes(_attributes, [self layoutAttributes], layout.size);
   view.renderer = renderer;
   view.isAccessibilityElement = _accessibilityContext.isAccessibilityElement.boolValue;
   view.accessibilityLabel = _accessibilityContext.accessibilityLabel.hasText() ? _accessibilityContext.accessibilityLabel.value() : _attributes.attributedString.string;
@@ -28,4 +28,11 @@
 
 @end
 
+/**
+ Lets text component layers showing short, single-line text share a few atlas images for their rasters, pointing their
+ contentsRect at their part, instead of each caching its own bitmap. A raster is copied into the atlas off the main thread
+ after it is first drawn, and is shown from it once its atlas page is sealed. Off by default. Main thread only.
+ */
+void CKTextComponentLayerSetRasterAtlasEnabled(BOOL enabled);
+
 #endif
@@ -17,6 +17,7 @@
 #import <RenderCore/RCAssert.h>
 
 #import "CKTextComponentLayerHighlighter.h"
+#import "CKTextComponentRasterAtlas.h"
 
 static CK::TextKit::Renderer::Cache *rasterContentsCache()
 {
@@ -25,9 +26,26 @@ static CK::TextKit::Renderer::Cache *rasterContentsCache()
   return __rasterContentsCache;
 }
 
+CK::TextKit::RasterAtlas &CKTextComponentLayerRasterAtlas()
+{
+  // Six 512x512 pages, 6MB at most, like the raster contents cache. A page that stops filling up is shown after 0.5s.
+  static CK::TextKit::RasterAtlas *__rasterAtlas (new CK::TextKit::RasterAtlas(512, 6, 0.5));
+  return *__rasterAtlas;
+}
+
+static BOOL rasterAtlasEnabled = NO;
+
+void CKTextComponentLayerSetRasterAtlasEnabled(BOOL enabled)
+{
+  RCCAssertMainThread();
+  rasterAtlasEnabled = enabled;
+}
+
 @implementation CKTextComponentLayer
 {
   CKTextComponentLayerHighlighter *_highlighter;
+  /** Where the contents about to be applied live in the atlas, if they do. */
+  CK::TextKit::AtlasContents _atlasContents;
 }
 
 + (id)defaultValueForKey:(NSString *)key
@@ -83,8 +101,25 @@ static CK::TextKit::Renderer::Cache *rasterContentsCache()
   return _renderer;
 }
 
+- (BOOL)_usesRasterAtlas
+{
+  if (!rasterAtlasEnabled) {
+    return NO;
+  }
+  const CGSize size = self.bounds.size;
+  const CGFloat scale = self.contentsScale;
+  return CKTextComponentLayerRasterAtlas().canHoldRasterOfSize(ceil(size.width * scale), ceil(size.height * scale))
+  && _renderer.lineCount <= 1;
+}
+
 - (id)willDisplayAsynchronouslyWithDrawParameters:(id<NSObject>)drawParameters
 {
+  if ([self _usesRasterAtlas]) {
+    _atlasContents = CKTextComponentLayerRasterAtlas().contentsForKey({_renderer.attributes, _renderer.constrainedSize});
+    if (_atlasContents.image) {
+      return _atlasContents.image;
+    }
+  }
   return rasterContentsCache()->objectForKey({_renderer.attributes, _renderer.constrainedSize});
 }
 
@@ -92,11 +127,27 @@ static CK::TextKit::Renderer::Cache *rasterContentsCache()
 {
   if (newContents) {
     CGImageRef imageRef = (__bridge CGImageRef)newContents;
+    // Until the atlas page it is copied into is sealed, the raster is shown, and found again, on its own.
+    if ([self _usesRasterAtlas]) {
+      CKTextComponentLayerRasterAtlas().insert({_renderer.attributes, _renderer.constrainedSize}, imageRef);
+    }
     NSUInteger bytes = CGImageGetBytesPerRow(imageRef) * CGImageGetHeight(imageRef);
     rasterContentsCache()->cacheObject({_renderer.attributes, _renderer.constrainedSize}, newContents, bytes);
   }
 }
 
+- (void)applyAsyncDisplayContents:(id)contents withDrawParameters:(id<NSObject>)drawParameters
+{
+  if (_atlasContents.image) {
+    self.contents = _atlasContents.image;
+    self.contentsRect = _atlasContents.contentsRect;
+  } else {
+    self.contents = contents;
+    self.contentsRect = {{0, 0}, {1, 1}};
+  }
+  _atlasContents = {};
+}
+
 + (void)drawInContext:(CGContextRef)context parameters:(CKTextKitRenderer *)renderer
 {
   CGRect boundsRect = CGContextGetClipBoundingBox(context);
@@ -105,6 +156,8 @@ static CK::TextKit::Renderer::Cache *rasterContentsCache()
 
 - (void)drawInContext:(CGContextRef)ctx
 {
+  // The contents drawn here replace any shown from the raster atlas.
+  self.contentsRect = {{0, 0}, {1, 1}};
   // When we're drawing synchronously we need to manually fill the bg color because CKAsyncLayer doesn't.
   if (self.opaque && self.backgroundColor != NULL) {
     CGRect boundsRect = CGContextGetClipBoundingBox(ctx);
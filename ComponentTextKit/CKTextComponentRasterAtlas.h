@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <ComponentKit/CKDefines.h>
+
+#if CK_NOT_SWIFT
+
+#import <mutex>
+#import <unordered_map>
+#import <vector>
+
+#import <UIKit/UIKit.h>
+
+#import <ComponentTextKit/CKAtlasAllocator.h>
+#import <ComponentTextKit/CKTextKitRendererCache.h>
+
+namespace CK {
+  namespace TextKit {
+    /**
+     Where a raster lives in the atlas: the image of the page holding it, and the part of that image it covers, in the
+     unit coordinates of CALayer's contentsRect.
+     */
+    struct AtlasContents {
+      id image;
+      CGRect contentsRect;
+    };
+
+    /**
+     Packs small rasters of text, such as short single-line labels, into a few shared backing images instead of giving
+     each its own bitmap. Layers show their text by pointing their contentsRect at its part of a page.
+
+     Rasters are copied on a private serial queue into a page that no layer shows yet. A page is only handed out once it
+     is sealed: when it is full, or when nothing has been added to it for a while. Its image is then made once and never
+     drawn into again, so layers showing it never make Core Graphics copy the page. Until their page is sealed, rasters
+     are not found in the atlas. Each raster is followed by a transparent pixel on the right and at the bottom, so
+     filtering at the edges of a contentsRect doesn't pick up neighbouring rasters.
+
+     Pages are evicted as a whole, least recently used first, once they are all full. Layers already showing an evicted
+     raster keep the page image they were given. Safe to use from any thread.
+     */
+    class RasterAtlas {
+    public:
+      /**
+       @param sealDelay How long, in seconds, the page being filled can go without new rasters before it is sealed.
+       */
+      RasterAtlas(NSUInteger pageSize, NSUInteger maximumPageCount, NSTimeInterval sealDelay);
+      ~RasterAtlas();
+
+      /** Whether a raster of this size, in pixels, is small enough to be stored in the atlas. */
+      bool canHoldRasterOfSize(NSUInteger width, NSUInteger height) const;
+
+      /** Returns the contents for the key, with a nil image if the atlas doesn't hold it or its page isn't sealed yet. */
+      AtlasContents contentsForKey(const Renderer::Key &key);
+
+      /** Copies the raster into the atlas asynchronously, unless it is too big or already there. */
+      void insert(const Renderer::Key &key, CGImageRef raster);
+
+      /** Waits for pending insertions, then seals the page being filled. */
+      void sealPendingPage();
+
+      void removeAllObjects();
+
+    private:
+      void insertOnQueue(const Renderer::Key &key, CGImageRef raster);
+      void sealOpenPageOnQueue();
+      void dropStaleOpenPageOnQueue();
+      AtlasContents contentsForAllocation(const AtlasAllocator::Allocation &allocation);
+
+      const NSTimeInterval _sealDelay;
+      dispatch_queue_t _queue;
+      /** Fires on _queue once the page being filled has gone _sealDelay without new rasters. */
+      dispatch_source_t _sealTimer;
+
+      std::mutex _mutex; // protects everything below, up to the queue's own state
+      AtlasAllocator _allocator;
+      /** The image of each sealed page; nil for the page being filled. */
+      std::vector<id> _pageImages;
+      std::unordered_map<Renderer::Key, AtlasAllocator::Allocation, Renderer::KeyHasher> _allocationsByKey;
+      std::unordered_map<NSUInteger, Renderer::Key> _keysByIdentifier;
+      /** Bumped by removeAllObjects, so the queue drops a page it was filling before. */
+      NSUInteger _generation;
+
+      // Only used on _queue.
+      CGContextRef _openContext;
+      NSUInteger _openPage;
+      NSUInteger _openGeneration;
+
+      ApplicationObserver *_applicationObserver;
+    };
+  }
+}
+
+/** The atlas shared by text component layers. Exposed for tests. */
+CK::TextKit::RasterAtlas &CKTextComponentLayerRasterAtlas();
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import "CKTextComponentRasterAtlas.h"
+
+#import <algorithm>
+
+// Short single-line text only: anything taller than this is left to the regular raster cache.
+static const NSUInteger kMaximumRasterHeight = 128;
+// Transparent gutter to the right of and below each raster.
+static const NSUInteger kPadding = 1;
+
+namespace CK {
+  namespace TextKit {
+    RasterAtlas::RasterAtlas(NSUInteger pageSize, NSUInteger maximumPageCount, NSTimeInterval sealDelay)
+    : _sealDelay(sealDelay),
+    _queue(dispatch_queue_create("com.facebook.CKTextComponentRasterAtlas", DISPATCH_QUEUE_SERIAL)),
+    _allocator(pageSize, pageSize, maximumPageCount),
+    _generation(0),
+    _openContext(NULL),
+    _openPage(0),
+    _openGeneration(0)
+    {
+      _sealTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _queue);
+      dispatch_source_set_timer(_sealTimer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+      dispatch_source_set_event_handler(_sealTimer, ^{
+        sealOpenPageOnQueue();
+      });
+      dispatch_resume(_sealTimer);
+
+      _applicationObserver = new ApplicationObserver([this] {
+        removeAllObjects();
+      }, [this] {
+        removeAllObjects();
+      });
+    }
+
+    RasterAtlas::~RasterAtlas()
+    {
+      delete _applicationObserver;
+      dispatch_source_cancel(_sealTimer);
+      // Let insertions already on the queue finish before the context goes away.
+      dispatch_sync(_queue, ^{});
+      CGContextRelease(_openContext);
+    }
+
+    bool RasterAtlas::canHoldRasterOfSize(NSUInteger width, NSUInteger height) const
+    {
+      return width > 0 && height > 0 && height <= kMaximumRasterHeight && width + kPadding <= _allocator.pageWidth();
+    }
+
+    AtlasContents RasterAtlas::contentsForAllocation(const AtlasAllocator::Allocation &allocation)
+    {
+      if (allocation.page >= _pageImages.size() || _pageImages[allocation.page] == nil) {
+        return {nil, CGRectZero};
+      }
+      const CGFloat pageWidth = _allocator.pageWidth();
+      const CGFloat pageHeight = _allocator.pageHeight();
+      return {
+        _pageImages[allocation.page],
+        {
+          {allocation.x / pageWidth, allocation.y / pageHeight},
+          {(allocation.width - kPadding) / pageWidth, (allocation.height - kPadding) / pageHeight}
+        },
+      };
+    }
+
+    AtlasContents RasterAtlas::contentsForKey(const Renderer::Key &key)
+    {
+      std::lock_guard<std::mutex> l(_mutex);
+      const auto it = _allocationsByKey.find(key);
+      if (it == _allocationsByKey.end()) {
+        return {nil, CGRectZero};
+      }
+      const AtlasContents contents = contentsForAllocation(it->second);
+      if (contents.image) {
+        _allocator.touch(it->second.page);
+      }
+      return contents;
+    }
+
+    void RasterAtlas::insert(const Renderer::Key &key, CGImageRef raster)
+    {
+      if (!canHoldRasterOfSize(CGImageGetWidth(raster), CGImageGetHeight(raster))) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_allocationsByKey.find(key) != _allocationsByKey.end()) {
+          return;
+        }
+      }
+      const Renderer::Key keyCopy = key;
+      id rasterObject = (__bridge id)raster;
+      dispatch_async(_queue, ^{
+        insertOnQueue(keyCopy, (__bridge CGImageRef)rasterObject);
+      });
+    }
+
+    void RasterAtlas::insertOnQueue(const Renderer::Key &key, CGImageRef raster)
+    {
+      const NSUInteger rasterWidth = CGImageGetWidth(raster);
+      const NSUInteger rasterHeight = CGImageGetHeight(raster);
+      dropStaleOpenPageOnQueue();
+
+      AtlasAllocator::Allocation allocation;
+      NSUInteger generation;
+      {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_allocationsByKey.find(key) != _allocationsByKey.end()) {
+          return;
+        }
+        std::vector<NSUInteger> evicted;
+        if (!_allocator.allocate(rasterWidth + kPadding, rasterHeight + kPadding, allocation, evicted)) {
+          return;
+        }
+        for (const auto identifier : evicted) {
+          const auto evictedKey = _keysByIdentifier.find(identifier);
+          if (evictedKey != _keysByIdentifier.end()) {
+            _allocationsByKey.erase(evictedKey->second);
+            _keysByIdentifier.erase(evictedKey);
+          }
+        }
+        // An evicted page is filled again from scratch; layers showing its old image keep it.
+        _pageImages.resize(std::max<size_t>(_pageImages.size(), allocation.page + 1));
+        _pageImages[allocation.page] = nil;
+        _allocationsByKey.emplace(key, allocation);
+        _keysByIdentifier.emplace(allocation.identifier, key);
+        generation = _generation;
+      }
+
+      // Only one page is filled at a time: moving on to another one seals the current one.
+      if (_openContext != NULL && allocation.page != _openPage) {
+        sealOpenPageOnQueue();
+      }
+      if (_openContext == NULL) {
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+        _openContext = CGBitmapContextCreate(NULL,
+                                             _allocator.pageWidth(),
+                                             _allocator.pageHeight(),
+                                             8,
+                                             0,
+                                             colorSpace,
+                                             kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+        CGColorSpaceRelease(colorSpace);
+        if (_openContext == NULL) {
+          std::lock_guard<std::mutex> l(_mutex);
+          _allocationsByKey.erase(key);
+          _keysByIdentifier.erase(allocation.identifier);
+          return;
+        }
+        _openPage = allocation.page;
+        _openGeneration = generation;
+      }
+
+      // Core Graphics puts the origin at the bottom left of the page, the allocator at the top left.
+      const CGFloat top = _allocator.pageHeight() - allocation.y;
+      CGContextClearRect(_openContext, {
+        {(CGFloat)allocation.x, top - allocation.height},
+        {(CGFloat)allocation.width, (CGFloat)allocation.height}
+      });
+      CGContextDrawImage(_openContext, {
+        {(CGFloat)allocation.x, top - rasterHeight},
+        {(CGFloat)rasterWidth, (CGFloat)rasterHeight}
+      }, raster);
+
+      dispatch_source_set_timer(_sealTimer,
+                                dispatch_time(DISPATCH_TIME_NOW, (int64_t)(_sealDelay * NSEC_PER_SEC)),
+                                DISPATCH_TIME_FOREVER,
+                                (uint64_t)(_sealDelay * NSEC_PER_SEC / 10));
+    }
+
+    void RasterAtlas::sealOpenPageOnQueue()
+    {
+      dispatch_source_set_timer(_sealTimer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+      if (_openContext == NULL) {
+        return;
+      }
+      // Releasing the context right away means nothing ever draws into the page again, so Core Graphics never has to
+      // copy it away from the image.
+      id image = CFBridgingRelease(CGBitmapContextCreateImage(_openContext));
+      CGContextRelease(_openContext);
+      _openContext = NULL;
+
+      std::lock_guard<std::mutex> l(_mutex);
+      if (_openGeneration == _generation) {
+        _pageImages[_openPage] = image;
+        _allocator.seal(_openPage);
+      }
+    }
+
+    void RasterAtlas::dropStaleOpenPageOnQueue()
+    {
+      if (_openContext == NULL) {
+        return;
+      }
+      std::lock_guard<std::mutex> l(_mutex);
+      if (_openGeneration != _generation) {
+        CGContextRelease(_openContext);
+        _openContext = NULL;
+      }
+    }
+
+    void RasterAtlas::sealPendingPage()
+    {
+      dispatch_sync(_queue, ^{
+        sealOpenPageOnQueue();
+      });
+    }
+
+    void RasterAtlas::removeAllObjects()
+    {
+      {
+        std::lock_guard<std::mutex> l(_mutex);
+        _allocator.clear();
+        _allocationsByKey.clear();
+        _keysByIdentifier.clear();
+        _pageImages.clear();
+        _generation++;
+      }
+      dispatch_async(_queue, ^{
+        dropStaleOpenPageOnQueue();
+      });
+    }
+  }
+}
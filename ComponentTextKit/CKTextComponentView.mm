@@ -25,6 +25,7 @@
 @implementation CKTextComponentView
 {
   CKTextComponentViewControlTracker *_controlTracker;
+  BOOL _needsDisplayInWindow;
 }
 
 + (Class)layerClass
@@ -80,6 +81,26 @@
   return [self.textLayer renderer];
 }
 
+- (void)didMoveToWindow
+{
+  [super didMoveToWindow];
+  CKTextComponentLayer *textLayer = self.textLayer;
+  if (self.window == nil) {
+    // Text that is no longer on screen shouldn't hold up the display queue; draw it again if it comes back.
+    if (textLayer.hasPendingAsyncDisplay) {
+      [textLayer cancelAsyncDisplay];
+      _needsDisplayInWindow = YES;
+    }
+    textLayer.displayPriority = CKAsyncTransactionOperationPriorityDefault;
+  } else {
+    textLayer.displayPriority = CKAsyncTransactionOperationPriorityHigh;
+    if (_needsDisplayInWindow) {
+      _needsDisplayInWindow = NO;
+      [textLayer setNeedsDisplay];
+    }
+  }
+}
+
 #pragma mark - Control Tracking
 
 - (CKTextComponentViewControlTracker *)controlTracker
@@ -26,6 +26,9 @@ extern NSString *const CKTextKitTruncationAttributeName;
  */
 extern NSString *const CKTextKitEntityAttributeName;
 
+/** String attributes that TextKit only uses when drawing glyphs, never when laying them out. */
+NSArray<NSAttributedStringKey> *CKTextKitPaintAttributeNames();
+
 static inline BOOL _objectsEqual(id<NSObject> obj1, id<NSObject> obj2)
 {
   return obj1 == obj2 ? YES : [obj1 isEqual:obj2];
@@ -106,6 +109,12 @@ struct CKTextKitAttributes {
     };
   };
 
+  /**
+   Returns a copy in which everything that only changes how glyphs are painted, such as colors and shadows, is replaced
+   by the same placeholder values, so that two attributes which lay text out identically compare equal.
+   */
+  const CKTextKitAttributes layoutAttributes() const;
+
   bool operator==(const CKTextKitAttributes &other) const
   {
     // These comparisons are in a specific order to reduce the overall cost of this function.
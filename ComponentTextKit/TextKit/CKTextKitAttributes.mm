@@ -35,3 +35,57 @@ size_t CKTextKitAttributes::hash() const
   };
   return RCIntegerArrayHash(subhashes, CK_ARRAY_COUNT(subhashes));
 }
+
+NSArray<NSAttributedStringKey> *CKTextKitPaintAttributeNames()
+{
+  static NSArray<NSAttributedStringKey> *paintAttributeNames;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    paintAttributeNames = @[
+      NSForegroundColorAttributeName,
+      NSBackgroundColorAttributeName,
+      NSUnderlineColorAttributeName,
+      NSStrikethroughColorAttributeName,
+      NSStrokeColorAttributeName,
+      NSShadowAttributeName,
+    ];
+  });
+  return paintAttributeNames;
+}
+
+const CKTextKitAttributes CKTextKitAttributes::layoutAttributes() const
+{
+  static UIColor *placeholderColor = [UIColor blackColor];
+  static NSShadow *placeholderShadow = [NSShadow new];
+
+  // Values are replaced rather than removed, so that strings only compare equal if they paint the same ranges.
+  __block NSMutableAttributedString *layoutString = nil;
+  for (NSAttributedStringKey name in CKTextKitPaintAttributeNames()) {
+    id placeholder = [name isEqualToString:NSShadowAttributeName] ? placeholderShadow : placeholderColor;
+    [attributedString enumerateAttribute:name
+                                 inRange:{0, attributedString.length}
+                                 options:0
+                              usingBlock:^(id value, NSRange range, BOOL *stop) {
+                                if (value != nil && value != placeholder) {
+                                  if (layoutString == nil) {
+                                    layoutString = [attributedString mutableCopy];
+                                  }
+                                  [layoutString addAttribute:name value:placeholder range:range];
+                                }
+                              }];
+  }
+
+  return {
+    layoutString ?: attributedString,
+    truncationAttributedString,
+    avoidTailTruncationSet,
+    lineBreakMode,
+    maximumNumberOfLines,
+    shadowOffset,
+    // Whether there is a shadow at all decides how much the text is inset to make room for it.
+    shadowColor ? placeholderColor : nil,
+    shadowOpacity != 0 ? (CGFloat)1 : (CGFloat)0,
+    shadowRadius,
+    layoutManagerFactory
+  };
+}
@@ -25,7 +25,8 @@
 /**
  Initializes a context and its associated TextKit components.
 
- Initialization of TextKit components is a globally locking operation so be careful of bottlenecks with this class.
+ TextKit components are checked out of a pool and returned to it when the context is deallocated. Creating new
+ components is a globally locking operation, but only happens when more contexts are alive at once than ever before.
  */
 - (instancetype)initWithAttributedString:(NSAttributedString *)attributedString
                            lineBreakMode:(NSLineBreakMode)lineBreakMode
@@ -48,4 +49,13 @@
 
 @end
 
+struct CKTextKitContextPoolStatistics {
+  /** TextKit component stacks created, under the global lock, because the pool had none left. */
+  NSUInteger creations;
+  /** TextKit component stacks reused from the pool. */
+  NSUInteger reuses;
+};
+
+CKTextKitContextPoolStatistics CKTextKitContextGetPoolStatistics();
+
 #endif
@@ -9,9 +9,90 @@
  */
 
 #import <mutex>
+#import <unordered_map>
+#import <vector>
 
 #import "CKTextKitContext.h"
 
+typedef NSLayoutManager *(*CKTextKitLayoutManagerFactory)(void);
+
+namespace {
+  struct TextKitStack {
+    NSLayoutManager *layoutManager;
+    NSTextStorage *textStorage;
+    NSTextContainer *textContainer;
+  };
+
+  /**
+   Idle TextKit stacks, by the factory their layout manager was made with, since custom layout managers can't be
+   swapped for one another.
+   */
+  struct TextKitStackPool {
+    std::mutex mutex; // protects stacks and statistics
+    std::unordered_map<CKTextKitLayoutManagerFactory, std::vector<TextKitStack>> stacks;
+    CKTextKitContextPoolStatistics statistics;
+  };
+}
+
+// Idle stacks only hold empty text, so keeping a few around for each thread laying out text is cheap.
+static const size_t kMaximumIdleStacksPerFactory = 16;
+
+static TextKitStackPool &stackPool()
+{
+  static TextKitStackPool *pool = new TextKitStackPool();
+  return *pool;
+}
+
+static TextKitStack checkOutStack(CKTextKitLayoutManagerFactory layoutManagerFactory)
+{
+  auto &pool = stackPool();
+  {
+    std::lock_guard<std::mutex> l(pool.mutex);
+    auto &idleStacks = pool.stacks[layoutManagerFactory];
+    if (!idleStacks.empty()) {
+      const TextKitStack stack = idleStacks.back();
+      idleStacks.pop_back();
+      pool.statistics.reuses++;
+      return stack;
+    }
+    pool.statistics.creations++;
+  }
+
+  // Concurrently initialising TextKit components crashes (rdar://18448377) so we use a global lock.
+  static std::mutex *__static_mutex = new std::mutex;
+  std::lock_guard<std::mutex> l(*__static_mutex);
+  // Create the TextKit component stack with our default configuration.
+  NSTextStorage *textStorage = [[NSTextStorage alloc] init];
+  NSLayoutManager *layoutManager = layoutManagerFactory ? layoutManagerFactory() : [[NSLayoutManager alloc] init];
+  layoutManager.usesFontLeading = NO;
+  [textStorage addLayoutManager:layoutManager];
+  NSTextContainer *textContainer = [[NSTextContainer alloc] initWithSize:CGSizeZero];
+  // We want the text laid out up to the very edges of the container.
+  textContainer.lineFragmentPadding = 0;
+  [layoutManager addTextContainer:textContainer];
+  return {layoutManager, textStorage, textContainer};
+}
+
+static void checkInStack(CKTextKitLayoutManagerFactory layoutManagerFactory, const TextKitStack &stack)
+{
+  // Drop the text, and with it the glyphs and layout computed for it, before the stack goes idle.
+  [stack.textStorage setAttributedString:[[NSAttributedString alloc] init]];
+
+  auto &pool = stackPool();
+  std::lock_guard<std::mutex> l(pool.mutex);
+  auto &idleStacks = pool.stacks[layoutManagerFactory];
+  if (idleStacks.size() < kMaximumIdleStacksPerFactory) {
+    idleStacks.push_back(stack);
+  }
+}
+
+CKTextKitContextPoolStatistics CKTextKitContextGetPoolStatistics()
+{
+  auto &pool = stackPool();
+  std::lock_guard<std::mutex> l(pool.mutex);
+  return pool.statistics;
+}
+
 @implementation CKTextKitContext
 {
   // All TextKit operations (even non-mutative ones) must be executed serially.
@@ -20,6 +101,7 @@
   NSLayoutManager *_layoutManager;
   NSTextStorage *_textStorage;
   NSTextContainer *_textContainer;
+  CKTextKitLayoutManagerFactory _layoutManagerFactory;
 }
 
 - (instancetype)initWithAttributedString:(NSAttributedString *)attributedString
@@ -29,24 +111,27 @@
                     layoutManagerFactory:(NSLayoutManager*(*)(void))layoutManagerFactory
 {
   if (self = [super init]) {
-    // Concurrently initialising TextKit components crashes (rdar://18448377) so we use a global lock.
-    static std::mutex *__static_mutex = new std::mutex;
-    std::lock_guard<std::mutex> l(*__static_mutex);
-    // Create the TextKit component stack with our default configuration.
-    _textStorage = (attributedString ? [[NSTextStorage alloc] initWithAttributedString:attributedString] : [[NSTextStorage alloc] init]);
-    _layoutManager = layoutManagerFactory ? layoutManagerFactory() : [[NSLayoutManager alloc] init];
-    _layoutManager.usesFontLeading = NO;
-    [_textStorage addLayoutManager:_layoutManager];
-    _textContainer = [[NSTextContainer alloc] initWithSize:constrainedSize];
-    // We want the text laid out up to the very edges of the container.
-    _textContainer.lineFragmentPadding = 0;
+    _layoutManagerFactory = layoutManagerFactory;
+    const TextKitStack stack = checkOutStack(layoutManagerFactory);
+    _layoutManager = stack.layoutManager;
+    _textStorage = stack.textStorage;
+    _textContainer = stack.textContainer;
+
+    _textContainer.size = constrainedSize;
     _textContainer.lineBreakMode = lineBreakMode;
     _textContainer.maximumNumberOfLines = maximumNumberOfLines;
-    [_layoutManager addTextContainer:_textContainer];
+    if (attributedString) {
+      [_textStorage setAttributedString:attributedString];
+    }
   }
   return self;
 }
 
+- (void)dealloc
+{
+  checkInStack(_layoutManagerFactory, {_layoutManager, _textStorage, _textContainer});
+}
+
 - (void)performBlockWithLockedTextKitComponents:(void (^)(NSLayoutManager *,
                                                           NSTextStorage *,
                                                           NSTextContainer *))block
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <ComponentKit/CKDefines.h>
+
+#if CK_NOT_SWIFT
+
+#import <atomic>
+#import <mutex>
+#import <vector>
+
+#import <Foundation/Foundation.h>
+
+#import <ComponentTextKit/CKCacheImpl.h>
+#import <ComponentTextKit/CKTextKitRendererCache.h>
+
+namespace CK {
+  namespace TextKit {
+    namespace Measurement {
+      /**
+       What layout needs to know about a piece of text, without any of the TextKit objects used to compute it.
+       */
+      struct Metrics {
+        CGSize size;
+        /** Distance from the top of the text to the baseline of its first line. */
+        CGFloat baseline;
+        NSUInteger lineCount;
+      };
+
+      /**
+       Metrics measured at one constrained width, along with the range of widths over which the text breaks into the
+       same lines, and so measures the same: from its longest line up to the first width at which the leading word of
+       a line would fit at the end of the line before it.
+       */
+      struct Measured {
+        Metrics metrics;
+        CGFloat constrainedWidth;
+        CGFloat minimumWidth;
+        CGFloat maximumWidth;
+
+        bool isValidForWidth(CGFloat width) const
+        {
+          return width == constrainedWidth || (width >= minimumWidth && width < maximumWidth);
+        }
+      };
+
+      /** Lays out the text with a throwaway TextKit stack and returns its metrics. */
+      Measured measure(const CKTextKitAttributes &attributes, CGSize constrainedSize);
+
+      /**
+       Measures long text by laying out runs of whole paragraphs in separate TextKit stacks, concurrently, and stacking
+       their lines up as a single stack would.
+
+       Returns false without measuring when that could measure differently from measure(): for text under a couple of
+       thousand characters or of a single paragraph, text whose number of lines is limited or that doesn't fit the
+       constrained height, since those are truncated, and text with spacing before paragraphs.
+       */
+      bool measureParagraphs(const CKTextKitAttributes &attributes, CGSize constrainedSize, Measured &measured);
+
+      /**
+       Measurements are looked up by attributes and constrained height only; each of them then answers for every width
+       over which its line breaks stay the same.
+       */
+      struct Key {
+        CKTextKitAttributes attributes;
+        CGFloat constrainedHeight;
+
+        Key(CKTextKitAttributes a, CGFloat ch);
+
+        size_t hash;
+
+        bool operator==(const Key &other) const
+        {
+          return hash == other.hash
+          && constrainedHeight == other.constrainedHeight
+          && attributes == other.attributes;
+        }
+      };
+
+      struct KeyHasher {
+        size_t operator()(const Key &k) const
+        {
+          return k.hash;
+        }
+      };
+
+      struct Statistics {
+        NSUInteger hits;
+        NSUInteger misses;
+        /** Hits at a width other than the one the text was measured at: TextKit layouts avoided by range reuse. */
+        NSUInteger rangeHits;
+        /** Misses measured with measureParagraphs(). */
+        NSUInteger paragraphLayouts;
+      };
+
+      /**
+       Caches text metrics, keyed like the renderer cache but reusable across constrained widths.
+
+       Entries are a few words each, so many more of them fit than renderers would: size queries made during layout
+       can be answered without keeping NSLayoutManager and NSTextStorage stacks alive, leaving renderers to be built
+       when the text is about to be drawn. Re-laying out the same text at a slightly different width, as flexbox does
+       over its measure passes or a rotation does, hits as long as the text wraps the same way.
+       */
+      struct Cache {
+      private:
+        CK::CacheImpl<const Key, std::vector<Measured>, KeyHasher> cache;
+        std::mutex mutex;
+        Statistics statistics {};
+        std::atomic<bool> paragraphLayoutEnabled {false};
+        ApplicationObserver *applicationObserver;
+
+      public:
+        Cache(const std::string cacheName, const NSUInteger maxCost, const CGFloat compactionFactor) : cache(cacheName, maxCost, compactionFactor) {
+          applicationObserver = new ApplicationObserver([this] {
+            compact(0.95);
+          }, [this] {
+            removeAllObjects();
+          });
+        };
+
+        ~Cache() {
+          delete applicationObserver;
+        }
+
+        /** Returns the cached metrics for the text at this size, measuring and caching them on a miss. */
+        Metrics metrics(const CKTextKitAttributes &attributes, CGSize constrainedSize);
+
+        /** Whether misses for long text are measured with measureParagraphs(). Off by default. */
+        void setParagraphLayoutEnabled(bool enabled) {
+          paragraphLayoutEnabled = enabled;
+        }
+
+        void compact(double compactionFactor) {
+          std::lock_guard<std::mutex> l(mutex);
+          cache.compact(compactionFactor);
+        }
+
+        void removeAllObjects() {
+          std::lock_guard<std::mutex> l(mutex);
+          cache.removeAllObjects();
+        }
+
+        Statistics getStatistics() {
+          std::lock_guard<std::mutex> l(mutex);
+          return statistics;
+        }
+      };
+    };
+  };
+};
+
+#endif
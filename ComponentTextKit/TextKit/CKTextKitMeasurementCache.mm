@@ -0,0 +1,322 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <ComponentTextKit/CKTextKitMeasurementCache.h>
+
+#import <vector>
+
+#import <ComponentKit/CKMacros.h>
+#import <ComponentKit/RCEqualityHelpers.h>
+
+#import <ComponentTextKit/CKTextKitContext.h>
+#import <ComponentTextKit/CKTextKitRenderer.h>
+#import <ComponentTextKit/CKTextKitShadower.h>
+#import <ComponentTextKit/CKTextKitTruncating.h>
+
+// Text measured at many widths it can't be reused across, such as truncated text, keeps only its latest measurements.
+static const size_t kMaximumMeasurementsPerKey = 8;
+
+// Below this, setting up several TextKit stacks costs more than laying the text out in one.
+static const NSUInteger kMinimumParagraphLayoutLength = 2000;
+// Runs of paragraphs shorter than this are merged with the next so each stack gets a worthwhile share of the text.
+static const NSUInteger kMinimumParagraphRunLength = 500;
+
+namespace {
+  /** Lines of a run of paragraphs, laid out on their own, in the run's coordinate space. */
+  struct ParagraphRunLayout {
+    /** Union of the used rects of the lines, or CGRectNull if there are none. */
+    CGRect usedRect;
+    /** Bottom of the run's last line fragment, which is where the next run's first line starts. */
+    CGFloat height;
+    NSUInteger lineCount;
+    /** Baseline of the first line, only meaningful for the first run. */
+    CGFloat baseline;
+    CGFloat widthChangingLineBreaks;
+  };
+}
+
+/**
+ Returns the characters that would have to fit at the end of a line for its next line to start later: the text up to the
+ next line break opportunity, or, if the line was broken in the middle of a word too long for it, a single character.
+ */
+static NSRange leadingCharactersOfNextLine(NSString *string, CFStringTokenizerRef lineBreakTokenizer, NSUInteger index)
+{
+  NSRange range = [string rangeOfComposedCharacterSequenceAtIndex:index];
+  CFStringTokenizerGoToTokenAtIndex(lineBreakTokenizer, index);
+  const CFRange token = CFStringTokenizerGetCurrentTokenRange(lineBreakTokenizer);
+  if (token.location != (CFIndex)index || token.length <= 0) {
+    return range;
+  }
+  // TextKit may break inside what Unicode considers unbreakable, e.g. after the slashes and dots of URLs, so only count
+  // on the text up to and including the first punctuation or symbol of the segment.
+  static NSCharacterSet *possibleBreaks;
+  static NSCharacterSet *whitespace;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    NSMutableCharacterSet *characters = [NSMutableCharacterSet punctuationCharacterSet];
+    [characters formUnionWithCharacterSet:[NSCharacterSet symbolCharacterSet]];
+    possibleBreaks = [characters copy];
+    whitespace = [NSCharacterSet whitespaceAndNewlineCharacterSet];
+  });
+  NSUInteger end = index + token.length;
+  const NSRange possibleBreak = [string rangeOfCharacterFromSet:possibleBreaks options:0 range:NSMakeRange(index, end - index)];
+  if (possibleBreak.location != NSNotFound) {
+    end = NSMaxRange([string rangeOfComposedCharacterSequenceAtIndex:possibleBreak.location]);
+  }
+  // Trailing whitespace hangs past the end of a line without taking room in it.
+  while (end > NSMaxRange(range) && [whitespace characterIsMember:[string characterAtIndex:end - 1]]) {
+    end--;
+  }
+  range.length = MAX(NSMaxRange(range), end) - index;
+  return range;
+}
+
+/**
+ Returns the narrowest width, in the text container's coordinate space, at which a line would pull up the leading
+ characters of the line after it, or INFINITY if no width would change where the lines break.
+ */
+static CGFloat widthChangingLineBreaks(NSLayoutManager *layoutManager, NSTextStorage *textStorage, NSTextContainer *textContainer)
+{
+  NSString *string = textStorage.string;
+  NSCharacterSet *newlines = [NSCharacterSet newlineCharacterSet];
+  const NSUInteger numberOfGlyphs = [layoutManager numberOfGlyphs];
+  CFStringTokenizerRef lineBreakTokenizer = NULL;
+
+  CGFloat width = INFINITY;
+  for (NSRange lineGlyphRange = {0, 0}; NSMaxRange(lineGlyphRange) < numberOfGlyphs;) {
+    const CGRect lineRect = [layoutManager lineFragmentUsedRectForGlyphAtIndex:NSMaxRange(lineGlyphRange) effectiveRange:&lineGlyphRange];
+    if (NSMaxRange(lineGlyphRange) >= numberOfGlyphs) {
+      break;
+    }
+    const NSRange lineCharacterRange = [layoutManager characterRangeForGlyphRange:lineGlyphRange actualGlyphRange:NULL];
+    const NSUInteger nextCharacterIndex = NSMaxRange(lineCharacterRange);
+    const unichar lastCharacter = [string characterAtIndex:nextCharacterIndex - 1];
+    if ([newlines characterIsMember:lastCharacter]) {
+      // Hard line breaks stay where they are at any width.
+      continue;
+    }
+    if (lineBreakTokenizer == NULL) {
+      lineBreakTokenizer = CFStringTokenizerCreate(kCFAllocatorDefault,
+                                                   (__bridge CFStringRef)string,
+                                                   CFRangeMake(0, string.length),
+                                                   kCFStringTokenizerUnitLineBreak,
+                                                   NULL);
+    }
+    const NSRange nextCharacterRange = leadingCharactersOfNextLine(string, lineBreakTokenizer, nextCharacterIndex);
+    const NSRange nextGlyphRange = [layoutManager glyphRangeForCharacterRange:nextCharacterRange actualCharacterRange:NULL];
+    const CGRect nextRect = [layoutManager boundingRectForGlyphRange:nextGlyphRange inTextContainer:textContainer];
+    width = MIN(width, CGRectGetWidth(lineRect) + CGRectGetWidth(nextRect));
+  }
+  if (lineBreakTokenizer != NULL) {
+    CFRelease(lineBreakTokenizer);
+  }
+  return width;
+}
+
+namespace CK {
+  namespace TextKit {
+    namespace Measurement {
+      Measured measure(const CKTextKitAttributes &attributes, CGSize constrainedSize)
+      {
+        // The renderer, and the TextKit stack it owns, goes away as soon as it has been measured.
+        CKTextKitRenderer *renderer = [[CKTextKitRenderer alloc] initWithTextKitAttributes:attributes
+                                                                           constrainedSize:constrainedSize];
+        const Metrics metrics = {
+          renderer.size,
+          renderer.baseline,
+          renderer.lineCount,
+        };
+
+        // Truncated text would show more of itself given more room, and text clipped to the constrained width would
+        // measure wider, so either is only valid at the width it was measured at.
+        const std::vector<NSRange> visibleRanges = renderer.truncater.visibleRanges;
+        const bool truncated =
+        visibleRanges.size() != 1 || visibleRanges[0].length < attributes.attributedString.length;
+        if (truncated || metrics.size.width >= constrainedSize.width) {
+          return {metrics, constrainedSize.width, constrainedSize.width, constrainedSize.width};
+        }
+
+        __block CGFloat maximumWidth;
+        [renderer.context performBlockWithLockedTextKitComponents:^(NSLayoutManager *layoutManager, NSTextStorage *textStorage, NSTextContainer *textContainer) {
+          maximumWidth = widthChangingLineBreaks(layoutManager, textStorage, textContainer);
+        }];
+        // Shadow padding is negative, and is taken off the constrained width before the text is laid out.
+        const UIEdgeInsets shadowPadding = [renderer.shadower shadowPadding];
+        maximumWidth -= shadowPadding.left + shadowPadding.right;
+
+        return {
+          metrics,
+          constrainedSize.width,
+          metrics.size.width,
+          maximumWidth,
+        };
+      }
+
+      bool measureParagraphs(const CKTextKitAttributes &attributes, CGSize constrainedSize, Measured &measured)
+      {
+        NSAttributedString *attributedString = attributes.attributedString;
+        const NSUInteger length = attributedString.length;
+        if (attributes.maximumNumberOfLines != 0 || length < kMinimumParagraphLayoutLength) {
+          return false;
+        }
+
+        // TextKit may treat spacing before the first paragraph of a container differently from the same paragraph
+        // further down, so don't split such text.
+        __block BOOL hasParagraphSpacingBefore = NO;
+        [attributedString enumerateAttribute:NSParagraphStyleAttributeName
+                                     inRange:{0, length}
+                                     options:NSAttributedStringEnumerationLongestEffectiveRangeNotRequired
+                                  usingBlock:^(NSParagraphStyle *style, NSRange range, BOOL *stop) {
+                                    if (style.paragraphSpacingBefore != 0) {
+                                      hasParagraphSpacingBefore = YES;
+                                      *stop = YES;
+                                    }
+                                  }];
+        if (hasParagraphSpacingBefore) {
+          return false;
+        }
+
+        // Runs end right after a paragraph separator, which stays with its paragraph as it does in a single stack.
+        NSString *string = attributedString.string;
+        const NSUInteger runLength = MAX(kMinimumParagraphRunLength, length / (2 * [NSProcessInfo processInfo].activeProcessorCount));
+        std::vector<NSRange> runs;
+        for (NSUInteger runStart = 0; runStart < length;) {
+          NSUInteger runEnd = runStart;
+          while (runEnd < length && runEnd - runStart < runLength) {
+            [string getParagraphStart:NULL end:&runEnd contentsEnd:NULL forRange:{runEnd, 0}];
+          }
+          runs.push_back({runStart, runEnd - runStart});
+          runStart = runEnd;
+        }
+        if (runs.size() < 2) {
+          return false;
+        }
+
+        CKTextKitShadower *shadower = [[CKTextKitShadower alloc] initWithShadowOffset:attributes.shadowOffset
+                                                                          shadowColor:attributes.shadowColor
+                                                                        shadowOpacity:attributes.shadowOpacity
+                                                                         shadowRadius:attributes.shadowRadius];
+        const CGSize insetSize = [shadower insetSizeWithConstrainedSize:constrainedSize];
+
+        std::vector<ParagraphRunLayout> layouts(runs.size());
+        ParagraphRunLayout *layoutsPointer = layouts.data();
+        const NSRange *runsPointer = runs.data();
+        const size_t runCount = runs.size();
+        dispatch_apply(runCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^(size_t i) {
+          CKTextKitContext *context =
+          [[CKTextKitContext alloc] initWithAttributedString:[attributedString attributedSubstringFromRange:runsPointer[i]]
+                                               lineBreakMode:attributes.lineBreakMode
+                                        maximumNumberOfLines:0
+                                             constrainedSize:{insetSize.width, CGFLOAT_MAX}
+                                        layoutManagerFactory:attributes.layoutManagerFactory];
+          [context performBlockWithLockedTextKitComponents:^(NSLayoutManager *layoutManager, NSTextStorage *textStorage, NSTextContainer *textContainer) {
+            [layoutManager ensureLayoutForTextContainer:textContainer];
+            ParagraphRunLayout layout = {CGRectNull, 0, 0, 0, INFINITY};
+            const NSUInteger numberOfGlyphs = [layoutManager numberOfGlyphs];
+            for (NSRange lineRange = {0, 0}; NSMaxRange(lineRange) < numberOfGlyphs;) {
+              const CGRect lineRect = [layoutManager lineFragmentRectForGlyphAtIndex:NSMaxRange(lineRange) effectiveRange:&lineRange];
+              layout.usedRect = CGRectUnion(layout.usedRect, [layoutManager lineFragmentUsedRectForGlyphAtIndex:lineRange.location effectiveRange:NULL]);
+              layout.height = CGRectGetMaxY(lineRect);
+              layout.lineCount++;
+            }
+            // Only the text's last run can end with the empty line that follows a final line break.
+            if (i == runCount - 1 && layoutManager.extraLineFragmentTextContainer != nil) {
+              layout.usedRect = CGRectUnion(layout.usedRect, layoutManager.extraLineFragmentUsedRect);
+              layout.height = CGRectGetMaxY(layoutManager.extraLineFragmentRect);
+            }
+            if (i == 0 && numberOfGlyphs > 0) {
+              layout.baseline = CGRectGetMinY([layoutManager lineFragmentRectForGlyphAtIndex:0 effectiveRange:NULL])
+              + [layoutManager locationForGlyphAtIndex:0].y;
+            }
+            layout.widthChangingLineBreaks = widthChangingLineBreaks(layoutManager, textStorage, textContainer);
+            layoutsPointer[i] = layout;
+          }];
+        });
+
+        CGRect usedRect = CGRectNull;
+        CGFloat height = 0;
+        NSUInteger lineCount = 0;
+        CGFloat maximumWidth = INFINITY;
+        for (const auto &layout : layouts) {
+          usedRect = CGRectUnion(usedRect, CGRectOffset(layout.usedRect, 0, height));
+          height += layout.height;
+          lineCount += layout.lineCount;
+          maximumWidth = MIN(maximumWidth, layout.widthChangingLineBreaks);
+        }
+        // A single stack would stop at the constrained height and truncate: leave that to measure().
+        if (CGRectIsNull(usedRect) || height > insetSize.height) {
+          return false;
+        }
+
+        // From here on, the same as a renderer sizing itself and measure() deriving the range of widths.
+        const CGRect boundingRect = CGRectIntersection(usedRect, {.size = constrainedSize});
+        const UIEdgeInsets shadowPadding = [shadower shadowPadding];
+        const Metrics metrics = {
+          [shadower outsetSizeWithInsetSize:boundingRect.size],
+          layouts[0].baseline - shadowPadding.top,
+          lineCount,
+        };
+        if (metrics.size.width >= constrainedSize.width) {
+          measured = {metrics, constrainedSize.width, constrainedSize.width, constrainedSize.width};
+        } else {
+          measured = {metrics, constrainedSize.width, metrics.size.width, maximumWidth - (shadowPadding.left + shadowPadding.right)};
+        }
+        return true;
+      }
+
+      Key::Key(CKTextKitAttributes a, CGFloat ch) : attributes(a), constrainedHeight(ch) {
+        // Precompute hash to avoid paying cost every time getHash is called.
+        NSUInteger subhashes[] = {
+          attributes.hash(),
+          std::hash<CGFloat>()(constrainedHeight),
+        };
+        hash = RCIntegerArrayHash(subhashes, CK_ARRAY_COUNT(subhashes));
+      }
+
+      Metrics Cache::metrics(const CKTextKitAttributes &attributes, CGSize constrainedSize)
+      {
+        const Key key {attributes, constrainedSize.height};
+        {
+          std::lock_guard<std::mutex> l(mutex);
+          for (const auto &measured : cache.find(key, {})) {
+            if (measured.isValidForWidth(constrainedSize.width)) {
+              statistics.hits++;
+              if (measured.constrainedWidth != constrainedSize.width) {
+                statistics.rangeHits++;
+              }
+              return measured.metrics;
+            }
+          }
+          statistics.misses++;
+        }
+
+        // Text is measured outside of the lock so that measuring different text can happen concurrently.
+        Measured measured;
+        const bool measuredParagraphs = paragraphLayoutEnabled && measureParagraphs(attributes, constrainedSize, measured);
+        if (!measuredParagraphs) {
+          measured = measure(attributes, constrainedSize);
+        }
+
+        std::lock_guard<std::mutex> l(mutex);
+        if (measuredParagraphs) {
+          statistics.paragraphLayouts++;
+        }
+        auto measurements = cache.find(key, {}, false);
+        if (measurements.size() == kMaximumMeasurementsPerKey) {
+          measurements.erase(measurements.begin());
+        }
+        measurements.push_back(measured);
+        // Each measurement costs 1, so the cache's limit counts measurements rather than pieces of text.
+        cache.insert(key, measurements, measurements.size());
+        return measured.metrics;
+      }
+    }
+  }
+}
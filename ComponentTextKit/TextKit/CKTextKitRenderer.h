@@ -46,6 +46,15 @@
 - (instancetype)initWithTextKitAttributes:(const CKTextKitAttributes &)textComponentAttributes
                           constrainedSize:(const CGSize)constrainedSize;
 
+/**
+ Makes a renderer that reuses the TextKit layout of another one instead of laying the text out again, and only paints
+ it differently.
+ @discussion The attributes must lay out exactly like the renderer's: their layoutAttributes() must be equal. Returns nil
+ if the layout can't be repainted on this OS, in which case the regular initializer must be used.
+ */
+- (instancetype)initWithTextKitAttributes:(const CKTextKitAttributes &)attributes
+                      repaintingRenderer:(CKTextKitRenderer *)renderer;
+
 @property (nonatomic, strong, readonly) CKTextKitContext *context;
 
 @property (nonatomic, strong, readonly) id<CKTextKitTruncating> truncater;
@@ -71,6 +80,20 @@
  */
 - (CGSize)size;
 
+/*
+ Returns the distance from the top of the renderer's bounds to the baseline of the first line, or 0 for empty text.
+ */
+- (CGFloat)baseline;
+
+#pragma mark - Memory
+
+/*
+ A rough estimate of the memory held by the renderer's TextKit objects, in bytes: their fixed overhead plus the glyphs,
+ line fragments and attributed string storage of its text. Meant for weighing renderers against each other in caches.
+ Renderers repainting another's layout only count their paint attributes, since the TextKit objects are the other's.
+ */
+- (NSUInteger)estimatedByteCost;
+
 #pragma mark - Text Ranges
 
 /*
@@ -32,6 +32,9 @@ static NSCharacterSet *_defaultAvoidTruncationCharacterSet()
 
 @implementation CKTextKitRenderer {
   CGSize _calculatedSize;
+  /** Set for renderers sharing another's layout: the paint attributes of each run of the visible text. */
+  std::vector<std::pair<NSRange, NSDictionary<NSAttributedStringKey, id> *>> _paintRuns;
+  BOOL _repaintsSharedLayout;
 }
 
 #pragma mark - Initialization
@@ -67,6 +70,48 @@ static NSCharacterSet *_defaultAvoidTruncationCharacterSet()
   return self;
 }
 
+- (instancetype)initWithTextKitAttributes:(const CKTextKitAttributes &)attributes
+                      repaintingRenderer:(CKTextKitRenderer *)renderer
+{
+  // Drawing different paint attributes over the same layout relies on the layout manager's temporary attributes.
+  if (@available(iOS 13.0, tvOS 13.0, *)) {
+  } else {
+    return nil;
+  }
+  RCAssert(attributes.layoutAttributes() == renderer.attributes.layoutAttributes(),
+           @"Only the paint of the text may differ from the renderer's");
+
+  if (self = [super init]) {
+    _constrainedSize = renderer.constrainedSize;
+    _attributes = attributes;
+    _shadower = [[CKTextKitShadower alloc] initWithShadowOffset:attributes.shadowOffset
+                                                    shadowColor:attributes.shadowColor
+                                                  shadowOpacity:attributes.shadowOpacity
+                                                   shadowRadius:attributes.shadowRadius];
+    _context = renderer.context;
+    _truncater = renderer.truncater;
+    _calculatedSize = renderer.size;
+    _repaintsSharedLayout = YES;
+
+    // Truncation only ever removes the end of the text, so the visible characters are where they are in the string.
+    NSArray<NSAttributedStringKey> *paintAttributeNames = CKTextKitPaintAttributeNames();
+    for (const NSRange &visibleRange : _truncater.visibleRanges) {
+      [attributes.attributedString enumerateAttributesInRange:visibleRange
+                                                      options:0
+                                                   usingBlock:^(NSDictionary<NSAttributedStringKey, id> *attrs, NSRange range, BOOL *stop) {
+                                                     NSMutableDictionary<NSAttributedStringKey, id> *paintAttributes = [NSMutableDictionary dictionary];
+                                                     for (NSAttributedStringKey name in paintAttributeNames) {
+                                                       paintAttributes[name] = attrs[name];
+                                                     }
+                                                     if (paintAttributes.count > 0) {
+                                                       self->_paintRuns.push_back({range, paintAttributes});
+                                                     }
+                                                   }];
+    }
+  }
+  return self;
+}
+
 #pragma mark - Sizing
 
 - (void)_calculateSize
@@ -96,6 +141,20 @@ static NSCharacterSet *_defaultAvoidTruncationCharacterSet()
   return _calculatedSize;
 }
 
+- (CGFloat)baseline
+{
+  __block CGFloat baseline = 0;
+  [_context performBlockWithLockedTextKitComponents:^(NSLayoutManager *layoutManager, NSTextStorage *textStorage, NSTextContainer *textContainer) {
+    if ([layoutManager numberOfGlyphs] == 0) {
+      return;
+    }
+    const CGRect lineRect = [layoutManager lineFragmentRectForGlyphAtIndex:0 effectiveRange:NULL];
+    baseline = CGRectGetMinY(lineRect) + [layoutManager locationForGlyphAtIndex:0].y;
+  }];
+  // Text is drawn inset by the shadow padding, which is negative.
+  return baseline - [_shadower shadowPadding].top;
+}
+
 #pragma mark - Drawing
 
 - (void)drawInContext:(CGContextRef)context bounds:(CGRect)bounds
@@ -111,14 +170,64 @@ static NSCharacterSet *_defaultAvoidTruncationCharacterSet()
 
   [_context performBlockWithLockedTextKitComponents:^(NSLayoutManager *layoutManager, NSTextStorage *textStorage, NSTextContainer *textContainer) {
     NSRange glyphRange = [layoutManager glyphRangeForBoundingRect:bounds inTextContainer:textContainer];
+    if (self->_repaintsSharedLayout) {
+      if (@available(iOS 13.0, tvOS 13.0, *)) {
+        // Temporary attributes take precedence over the text storage's when drawing, and never invalidate layout.
+        for (const auto &paintRun : self->_paintRuns) {
+          [layoutManager setTemporaryAttributes:paintRun.second forCharacterRange:paintRun.first];
+        }
+      }
+    }
     [layoutManager drawBackgroundForGlyphRange:glyphRange atPoint:shadowInsetBounds.origin];
     [layoutManager drawGlyphsForGlyphRange:glyphRange atPoint:shadowInsetBounds.origin];
+    if (self->_repaintsSharedLayout) {
+      if (@available(iOS 13.0, tvOS 13.0, *)) {
+        // The layout is shared: leave it painted as its own renderer expects.
+        [layoutManager setTemporaryAttributes:@{} forCharacterRange:{0, textStorage.length}];
+      }
+    }
   }];
 
   UIGraphicsPopContext();
   CGContextRestoreGState(context);
 }
 
+#pragma mark - Memory
+
+// Approximations of what TextKit keeps around, measured on 64-bit devices.
+static const NSUInteger kTextKitStackByteCost = 2048;
+static const NSUInteger kGlyphByteCost = 24;
+static const NSUInteger kLineFragmentByteCost = 96;
+static const NSUInteger kAttributeRunByteCost = 64;
+static const NSUInteger kRepaintingRendererByteCost = 256;
+
+- (NSUInteger)estimatedByteCost
+{
+  if (_repaintsSharedLayout) {
+    // The TextKit stack is charged to the renderer that laid it out.
+    return kRepaintingRendererByteCost + _paintRuns.size() * kAttributeRunByteCost;
+  }
+  __block NSUInteger cost = kTextKitStackByteCost;
+  [_context performBlockWithLockedTextKitComponents:^(NSLayoutManager *layoutManager, NSTextStorage *textStorage, NSTextContainer *textContainer) {
+    __block NSUInteger attributeRunCount = 0;
+    [textStorage enumerateAttributesInRange:{0, textStorage.length}
+                                    options:NSAttributedStringEnumerationLongestEffectiveRangeNotRequired
+                                 usingBlock:^(NSDictionary<NSAttributedStringKey, id> *attrs, NSRange range, BOOL *stop) {
+                                   attributeRunCount++;
+                                 }];
+    NSUInteger lineFragmentCount = 0;
+    const NSUInteger numberOfGlyphs = [layoutManager numberOfGlyphs];
+    for (NSRange lineRange = {0, 0}; NSMaxRange(lineRange) < numberOfGlyphs; lineFragmentCount++) {
+      [layoutManager lineFragmentRectForGlyphAtIndex:NSMaxRange(lineRange) effectiveRange:&lineRange];
+    }
+    cost += textStorage.length * sizeof(unichar)
+    + attributeRunCount * kAttributeRunByteCost
+    + numberOfGlyphs * kGlyphByteCost
+    + lineFragmentCount * kLineFragmentByteCost;
+  }];
+  return cost;
+}
+
 #pragma mark - String Ranges
 
 - (NSUInteger)lineCount
@@ -147,6 +147,18 @@ namespace CK {
         void removeAllObjects() {
           cache.removeAllObjects();
         }
+
+        void setMaxCost(NSUInteger maxCost) {
+          cache.setMaxCost(maxCost);
+        }
+
+        NSUInteger totalCost() {
+          return cache.totalCost();
+        }
+
+        NSUInteger peakCost() {
+          return cache.peakCost();
+        }
       };
     };
   };
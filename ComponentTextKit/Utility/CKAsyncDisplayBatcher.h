@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <ComponentKit/CKDefines.h>
+
+#if CK_NOT_SWIFT
+
+#include <atomic>
+
+#import <QuartzCore/QuartzCore.h>
+
+#import <ComponentTextKit/CKAsyncLayerInternal.h>
+#import <ComponentTextKit/CKAsyncTransaction.h>
+
+/** Everything needed to draw one async layer off the main thread, captured when it is displayed. */
+struct CKAsyncDisplay {
+  CGRect bounds;
+  CGFloat contentsScale;
+  BOOL opaque;
+  id backgroundColor;
+  std::atomic_int32_t *displaySentinel;
+  int32_t expectedDisplaySentinelValue;
+  id<CKAsyncLayerDrawingDelegate> drawingDelegate;
+  NSObject *drawParameters;
+  /** Displays of high priority are drawn before the others of their batch. */
+  CKAsyncTransactionOperationPriority priority;
+  /** Skipped if canceled before it is drawn. */
+  CKAsyncTransaction *transaction;
+  /** Skipped if canceled before it is drawn. */
+  CKAsyncTransactionOperationToken *token;
+  /** Called with the rendered CGImageRef, or nil if nothing was drawn. */
+  ck_async_transaction_complete_async_operation_block_t complete;
+};
+
+/**
+ Queues a display to be drawn with all the others queued during the current main run loop turn. Main thread only.
+
+ At the end of the turn, after Core Animation has committed and so displayed every layer that needed it, pending displays
+ are grouped by bitmap size and format, and drawn in at most one task per processor, so the displays of a size draw one
+ after the other and keep reusing the same pooled bitmaps. High priority displays are drawn first: ahead of the others of
+ their size, and with their sizes ahead of the sizes that have none. Every display then completes at once, in a single
+ main queue block.
+ */
+void CKAsyncDisplayBatcherAddDisplay(CKAsyncDisplay &&display);
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import "CKAsyncDisplayBatcher.h"
+
+#import <algorithm>
+#import <atomic>
+#import <climits>
+#import <map>
+#import <memory>
+#import <mutex>
+#import <tuple>
+#import <vector>
+
+#import <UIKit/UIKit.h>
+
+#import <RenderCore/RCAssert.h>
+
+namespace {
+  /** Displays that can reuse each other's bitmaps: same size in pixels, scale and opacity. */
+  struct SizeClass {
+    size_t pixelWidth;
+    size_t pixelHeight;
+    CGFloat contentsScale;
+    BOOL opaque;
+
+    bool operator<(const SizeClass &other) const
+    {
+      return std::tie(pixelWidth, pixelHeight, contentsScale, opaque)
+      < std::tie(other.pixelWidth, other.pixelHeight, other.contentsScale, other.opaque);
+    }
+  };
+
+  struct Batch {
+    std::vector<CKAsyncDisplay> displays;
+    std::vector<id> results;
+  };
+
+  struct PendingDisplays {
+    std::vector<CKAsyncDisplay> displays;
+    CFRunLoopObserverRef flushObserver = nullptr;
+  };
+}
+
+static std::mutex statisticsMutex; // protects statistics
+static CKAsyncLayerBatchedDisplayStatistics statistics;
+
+static PendingDisplays &pendingDisplays()
+{
+  static PendingDisplays *pending = new PendingDisplays();
+  return *pending;
+}
+
+static SizeClass sizeClassForDisplay(const CKAsyncDisplay &display)
+{
+  return {
+    (size_t)ceil(display.bounds.size.width * display.contentsScale),
+    (size_t)ceil(display.bounds.size.height * display.contentsScale),
+    display.contentsScale,
+    display.opaque,
+  };
+}
+
+static bool isCanceled(const CKAsyncDisplay &display)
+{
+  return (display.displaySentinel != nullptr && *display.displaySentinel != display.expectedDisplaySentinelValue)
+  || display.transaction.state == CKAsyncTransactionStateCanceled
+  || display.token.isCanceled;
+}
+
+/** Draws displays of one size class, one after the other, into bitmaps from the shared pool. */
+static void drawDisplays(const SizeClass &sizeClass, const std::vector<size_t> &indexes, Batch &batch)
+{
+  CK::BitmapContextPool &pool = CKAsyncLayerBitmapContextPool();
+  for (const auto index : indexes) {
+    const CKAsyncDisplay &display = batch.displays[index];
+    if (isCanceled(display)) {
+      continue;
+    }
+    CGColorRef backgroundColor = (__bridge CGColorRef)display.backgroundColor;
+    CK::BitmapContextPool::Bitmap *bitmap =
+    pool.checkOut(display.bounds.size,
+                  sizeClass.contentsScale,
+                  sizeClass.opaque,
+                  CKAsyncLayerBackgroundCoversEveryPixel(sizeClass.opaque, backgroundColor));
+    if (bitmap == nullptr) {
+      continue;
+    }
+    UIGraphicsPushContext(bitmap->context);
+    CKAsyncLayerFillBackground(bitmap->context, display.bounds, sizeClass.opaque, backgroundColor);
+    [display.drawingDelegate drawAsyncLayerInContext:bitmap->context parameters:display.drawParameters];
+    UIGraphicsPopContext();
+    batch.results[index] = CFBridgingRelease(pool.createImage(bitmap));
+  }
+}
+
+static void flush()
+{
+  RCCAssertMainThread();
+  auto &pending = pendingDisplays();
+  if (pending.displays.empty()) {
+    return;
+  }
+  const auto batch = std::make_shared<Batch>();
+  std::swap(batch->displays, pending.displays);
+  batch->results.resize(batch->displays.size());
+
+  std::map<SizeClass, std::vector<size_t>> sizeClasses;
+  for (size_t i = 0; i < batch->displays.size(); i++) {
+    const CKAsyncDisplay &display = batch->displays[i];
+    if (!CGRectIsEmpty(display.bounds)) {
+      sizeClasses[sizeClassForDisplay(display)].push_back(i);
+    }
+  }
+  std::map<SizeClass, size_t> highPriorityCounts;
+  for (auto &sizeClass : sizeClasses) {
+    auto &indexes = sizeClass.second;
+    const auto firstDefault = std::stable_partition(indexes.begin(), indexes.end(), [&](size_t index) {
+      return batch->displays[index].priority == CKAsyncTransactionOperationPriorityHigh;
+    });
+    highPriorityCounts[sizeClass.first] = firstDefault - indexes.begin();
+  }
+
+  // Spread size classes over at most one task per processor, largest first onto the least loaded task. Those with high
+  // priority displays go first, so each task draws them before any other.
+  std::vector<std::pair<SizeClass, std::vector<size_t>>> classes(sizeClasses.begin(), sizeClasses.end());
+  std::sort(classes.begin(), classes.end(), [&](const auto &a, const auto &b) {
+    const bool aHasHighPriority = highPriorityCounts[a.first] > 0;
+    const bool bHasHighPriority = highPriorityCounts[b.first] > 0;
+    if (aHasHighPriority != bHasHighPriority) {
+      return aHasHighPriority;
+    }
+    return a.second.size() > b.second.size();
+  });
+  const size_t taskCount = std::min(classes.size(), (size_t)[NSProcessInfo processInfo].activeProcessorCount);
+  std::vector<std::vector<size_t>> tasks(taskCount);
+  std::vector<size_t> taskLoads(taskCount);
+  for (size_t i = 0; i < classes.size(); i++) {
+    const auto leastLoadedTask = std::min_element(taskLoads.begin(), taskLoads.end()) - taskLoads.begin();
+    tasks[leastLoadedTask].push_back(i);
+    taskLoads[leastLoadedTask] += classes[i].second.size();
+  }
+
+  const auto sharedClasses = std::make_shared<std::vector<std::pair<SizeClass, std::vector<size_t>>>>(std::move(classes));
+  const auto drawDuration = std::make_shared<std::atomic<int64_t>>(0);
+  dispatch_group_t group = dispatch_group_create();
+  for (const auto &task : tasks) {
+    dispatch_group_async(group, [CKAsyncLayer displayQueue], ^{
+      const CFTimeInterval start = CACurrentMediaTime();
+      for (const auto classIndex : task) {
+        const auto &sizeClass = (*sharedClasses)[classIndex];
+        drawDisplays(sizeClass.first, sizeClass.second, *batch);
+      }
+      *drawDuration += (int64_t)((CACurrentMediaTime() - start) * NSEC_PER_SEC);
+    });
+  }
+  dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+    for (size_t i = 0; i < batch->displays.size(); i++) {
+      batch->displays[i].complete(batch->results[i]);
+    }
+    std::lock_guard<std::mutex> l(statisticsMutex);
+    statistics.batches++;
+    statistics.displays += batch->displays.size();
+    statistics.dispatches += taskCount;
+    statistics.drawDuration += (CFTimeInterval)drawDuration->load() / NSEC_PER_SEC;
+  });
+}
+
+void CKAsyncDisplayBatcherAddDisplay(CKAsyncDisplay &&display)
+{
+  RCCAssertMainThread();
+  auto &pending = pendingDisplays();
+  if (pending.flushObserver == nullptr) {
+    // Runs after Core Animation's commit, which is when layers that need it are displayed.
+    pending.flushObserver =
+    CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault,
+                                       kCFRunLoopBeforeWaiting | kCFRunLoopExit,
+                                       true,
+                                       INT_MAX,
+                                       ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+                                         flush();
+                                       });
+    CFRunLoopAddObserver(CFRunLoopGetMain(), pending.flushObserver, kCFRunLoopCommonModes);
+  }
+  pending.displays.push_back(std::move(display));
+}
+
+CKAsyncLayerBatchedDisplayStatistics CKAsyncLayerGetBatchedDisplayStatistics()
+{
+  std::lock_guard<std::mutex> l(statisticsMutex);
+  return statistics;
+}
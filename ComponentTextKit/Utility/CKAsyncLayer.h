@@ -14,6 +14,8 @@
 
 #import <QuartzCore/QuartzCore.h>
 
+#import <ComponentTextKit/CKAsyncTransaction.h>
+
 typedef NS_ENUM(NSUInteger, CKAsyncLayerDisplayMode) {
   /** Crawls up superlayers. If an async transaction container layer is found, renders async; otherwise, sync. */
   CKAsyncLayerDisplayModeDefault,
@@ -32,6 +34,22 @@ typedef NS_ENUM(NSUInteger, CKAsyncLayerDisplayMode) {
  */
 @property (atomic, assign) CKAsyncLayerDisplayMode displayMode;
 
+/**
+ @summary Where async displays of the layer go among those waiting on the display queue. Raise it for visible layers so
+ they are drawn before off-screen ones.
+
+ @desc With batched display enabled, it orders displays within their batch instead: high priority ones are drawn before
+ the others of the same run loop turn, though they complete together with them.
+
+ @default CKAsyncTransactionOperationPriorityDefault
+ */
+@property (nonatomic, assign) CKAsyncTransactionOperationPriority displayPriority;
+
+/**
+ @summary Whether an async display has been started and neither completed nor been canceled yet.
+ */
+@property (nonatomic, readonly) BOOL hasPendingAsyncDisplay;
+
 /**
  @summary Captures parameters from the receiver on the main thread that will be passed to drawInContext:parameters:
  on a background queue.  Override to capture values from any properties that are needed for drawing.
@@ -56,7 +74,8 @@ typedef NS_ENUM(NSUInteger, CKAsyncLayerDisplayMode) {
  @summary Cancels any pending async display.
 
  @desc If the receiver has had display called and is waiting for the dispatched async display to be executed, this will
- cancel that dispatched async display.  This method is useful to call when removing the receiver from the window.
+ cancel that dispatched async display, which is then skipped without drawing.  This method is useful to call when
+ removing the receiver from the window.
  */
 - (void)cancelAsyncDisplay;
 
@@ -77,4 +96,35 @@ typedef NS_ENUM(NSUInteger, CKAsyncLayerDisplayMode) {
 
 @end
 
+/**
+ Instead of each async display being dispatched on its own, draws all those started during a main run loop turn together
+ at the end of the turn, sharing one bitmap context per size and completing them all at once. Layers of high
+ displayPriority are drawn first within each batch. Off by default. Main thread only.
+ */
+void CKAsyncLayerSetBatchedDisplayEnabled(BOOL enabled);
+
+struct CKAsyncLayerBatchedDisplayStatistics {
+  NSUInteger batches;
+  NSUInteger displays;
+  /** Tasks dispatched to draw the batches, at most one per processor per batch. */
+  NSUInteger dispatches;
+  /** Time spent drawing, summed over all tasks, in seconds. */
+  CFTimeInterval drawDuration;
+};
+
+/** Totals for all batched displays so far. */
+CKAsyncLayerBatchedDisplayStatistics CKAsyncLayerGetBatchedDisplayStatistics();
+
+struct CKAsyncLayerBitmapPoolStatistics {
+  /** Bitmap buffers allocated because no idle one could be reused. */
+  NSUInteger allocations;
+  /** Async displays that drew into a reused buffer. */
+  NSUInteger reuses;
+  /** Bytes currently held by idle buffers. */
+  NSUInteger idleBytes;
+};
+
+/** How often async displays could reuse the pixel buffer of a previous display instead of allocating one. */
+CKAsyncLayerBitmapPoolStatistics CKAsyncLayerGetBitmapPoolStatistics();
+
 #endif
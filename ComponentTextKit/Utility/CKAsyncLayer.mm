@@ -16,12 +16,57 @@
 
 #import <RenderCore/RCAssert.h>
 
+#import "CKAsyncDisplayBatcher.h"
 #import "CKAsyncTransaction.h"
 #import "CKAsyncTransactionContainer.h"
 
+static BOOL batchedDisplayEnabled = NO;
+
+void CKAsyncLayerSetBatchedDisplayEnabled(BOOL enabled)
+{
+  RCCAssertMainThread();
+  batchedDisplayEnabled = enabled;
+}
+
+CK::BitmapContextPool &CKAsyncLayerBitmapContextPool()
+{
+  // Enough idle buffers for a screenful of text at 3x.
+  static CK::BitmapContextPool *pool = new CK::BitmapContextPool(8 * 1024 * 1024);
+  return *pool;
+}
+
+BOOL CKAsyncLayerBackgroundCoversEveryPixel(BOOL opaque, CGColorRef backgroundColor)
+{
+  return opaque && backgroundColor != NULL && CGColorGetAlpha(backgroundColor) == 1.0;
+}
+
+void CKAsyncLayerFillBackground(CGContextRef context, CGRect bounds, BOOL opaque, CGColorRef backgroundColor)
+{
+  if (backgroundColor == NULL) {
+    return;
+  }
+  CGContextSaveGState(context);
+  CGContextSetFillColorWithColor(context, backgroundColor);
+  if (CKAsyncLayerBackgroundCoversEveryPixel(opaque, backgroundColor)) {
+    CGContextConcatCTM(context, CGAffineTransformInvert(CGContextGetCTM(context)));
+    CGContextSetShouldAntialias(context, false);
+    CGContextFillRect(context, {CGPointZero, {(CGFloat)CGBitmapContextGetWidth(context), (CGFloat)CGBitmapContextGetHeight(context)}});
+  } else {
+    CGContextFillRect(context, bounds);
+  }
+  CGContextRestoreGState(context);
+}
+
+CKAsyncLayerBitmapPoolStatistics CKAsyncLayerGetBitmapPoolStatistics()
+{
+  const auto statistics = CKAsyncLayerBitmapContextPool().statistics();
+  return {statistics.allocations, statistics.reuses, statistics.idleBytes};
+}
+
 @implementation CKAsyncLayer
 {
   BOOL _needsAsyncDisplayOnly;
+  CKAsyncTransactionOperationToken *_displayToken;
 }
 
 #pragma mark - Class Methods
@@ -88,6 +133,9 @@
 {
   RCAssertMainThread();
   ++_displaySentinel;
+  [_displayToken cancel];
+  _displayToken = nil;
+  _hasPendingAsyncDisplay = NO;
 }
 
 + (ck_async_transaction_operation_block_t)asyncDisplayBlockWithBounds:(CGRect)bounds
@@ -111,20 +159,21 @@
       return nil;
     }
 
-    UIGraphicsBeginImageContextWithOptions(bounds.size, opaque, contentsScale);
-    CGContextRef bitmapContext = UIGraphicsGetCurrentContext();
-
-    if (backgroundColorObject != NULL) {
-      CGContextSetFillColorWithColor(bitmapContext, (CGColorRef)backgroundColorObject);
-      CGContextFillRect(bitmapContext, bounds);
+    CK::BitmapContextPool &pool = CKAsyncLayerBitmapContextPool();
+    CK::BitmapContextPool::Bitmap *bitmap =
+    pool.checkOut(bounds.size, contentsScale, opaque, CKAsyncLayerBackgroundCoversEveryPixel(opaque, (CGColorRef)backgroundColorObject));
+    if (bitmap == nullptr) {
+      return nil;
     }
+    CGContextRef bitmapContext = bitmap->context;
+    UIGraphicsPushContext(bitmapContext);
 
-    [drawingDelegate drawAsyncLayerInContext:bitmapContext parameters:drawParameters];
+    CKAsyncLayerFillBackground(bitmapContext, bounds, opaque, (CGColorRef)backgroundColorObject);
 
-    CGImageRef image = CGBitmapContextCreateImage(bitmapContext);
-    UIGraphicsEndImageContext();
+    [drawingDelegate drawAsyncLayerInContext:bitmapContext parameters:drawParameters];
 
-    return CFBridgingRelease(image);
+    UIGraphicsPopContext();
+    return CFBridgingRelease(pool.createImage(bitmap));
   } copy];
 }
 
@@ -171,7 +220,7 @@
   NSObject *drawParameters = [self drawParameters];
   id shortCircuitContents = [self willDisplayAsynchronouslyWithDrawParameters:drawParameters];
   if (shortCircuitContents) {
-    self.contents = shortCircuitContents;
+    [self applyAsyncDisplayContents:shortCircuitContents withDrawParameters:drawParameters];
     return;
   }
 
@@ -179,6 +228,40 @@
   CALayer *containerLayer = parentTransactionContainer ?: self;
   CKAsyncTransaction *transaction = containerLayer.ck_asyncTransaction;
   RCAssertNotNil(transaction, @"Expected async layer transaction to be non-nil");
+  ck_async_transaction_operation_completion_block_t completionBlock = ^(id<NSObject> value, BOOL canceled) {
+    RCCAssertMainThread();
+    if (self->_displaySentinel != displaySentinelValue) {
+      return;
+    }
+    self->_displayToken = nil;
+    self->_hasPendingAsyncDisplay = NO;
+    if (!canceled) {
+      [self didDisplayAsynchronously:value withDrawParameters:drawParameters];
+      [self applyAsyncDisplayContents:value withDrawParameters:drawParameters];
+    }
+  };
+
+  _hasPendingAsyncDisplay = YES;
+
+  if (batchedDisplayEnabled) {
+    _displayToken = [CKAsyncTransactionOperationToken new];
+    CKAsyncDisplayBatcherAddDisplay({
+      bounds,
+      self.contentsScale,
+      self.opaque,
+      (__bridge id)self.backgroundColor,
+      &_displaySentinel,
+      displaySentinelValue,
+      (id<CKAsyncLayerDrawingDelegate>)[self class],
+      drawParameters,
+      _displayPriority,
+      transaction,
+      _displayToken,
+      [transaction addExternalOperationWithToken:_displayToken completion:completionBlock],
+    });
+    return;
+  }
+
   ck_async_transaction_operation_block_t transactionBlock = [[self class] asyncDisplayBlockWithBounds:bounds
                                                                                         contentsScale:self.contentsScale
                                                                                                opaque:self.opaque
@@ -187,14 +270,10 @@
                                                                          expectedDisplaySentinelValue:displaySentinelValue
                                                                                       drawingDelegate:(id<CKAsyncLayerDrawingDelegate>)[self class]
                                                                                        drawParameters:drawParameters];
-  ck_async_transaction_operation_completion_block_t completionBlock = ^(id<NSObject> value, BOOL canceled) {
-    RCCAssertMainThread();
-    if (!canceled && (self->_displaySentinel == displaySentinelValue)) {
-      [self didDisplayAsynchronously:value withDrawParameters:drawParameters];
-      self.contents = value;
-    }
-  };
-  [transaction addOperationWithBlock:transactionBlock queue:[[self class] displayQueue] completion:completionBlock];
+  _displayToken = [transaction addOperationWithBlock:transactionBlock
+                                              queue:[[self class] displayQueue]
+                                           priority:_displayPriority
+                                         completion:completionBlock];
 }
 
 - (id)willDisplayAsynchronouslyWithDrawParameters:(id<NSObject>)drawParameters
@@ -206,6 +285,11 @@
 {
 }
 
+- (void)applyAsyncDisplayContents:(id)contents withDrawParameters:(id<NSObject>)drawParameters
+{
+  self.contents = contents;
+}
+
 #pragma mark - Drawing
 
 /// this method exists to provide an override point for CKAsyncLayer where it can use its drawingDelegate in place
@@ -16,6 +16,7 @@
 
 #import <ComponentTextKit/CKAsyncLayer.h>
 #import <ComponentTextKit/CKAsyncTransaction.h>
+#import <ComponentTextKit/CKBitmapContextPool.h>
 
 @class CKAsyncTransaction;
 
@@ -46,4 +47,17 @@
 
 @end
 
+/** The bitmaps async layers draw into, shared by all of them. */
+CK::BitmapContextPool &CKAsyncLayerBitmapContextPool();
+
+/** Whether filling the background of a bitmap sets every pixel, so it doesn't need to be cleared first. */
+BOOL CKAsyncLayerBackgroundCoversEveryPixel(BOOL opaque, CGColorRef backgroundColor);
+
+/**
+ Fills the background of a bitmap checked out of CKAsyncLayerBitmapContextPool() to draw `bounds` into. When the
+ background covers every pixel, the bitmap wasn't cleared, so the whole of it is filled in device space: a fill of
+ `bounds` in points would miss the pixels outside it, or only partly cover the last row or column of a fractional size.
+ */
+void CKAsyncLayerFillBackground(CGContextRef context, CGRect bounds, BOOL opaque, CGColorRef backgroundColor);
+
 #endif
@@ -34,6 +34,16 @@
  */
 - (void)didDisplayAsynchronously:(id)newContents withDrawParameters:(id<NSObject>)drawParameters;
 
+/**
+ Called on the main thread to show contents returned from -willDisplayAsynchronouslyWithDrawParameters: or rendered by
+ an async display. The default implementation sets them as the layer's contents; override to show them another way,
+ for instance as part of a larger image.
+
+ @param contents The CGImageRef to show.
+ @param drawParameters The parameters the contents were rendered with.
+ */
+- (void)applyAsyncDisplayContents:(id)contents withDrawParameters:(id<NSObject>)drawParameters;
+
 @end
 
 #endif
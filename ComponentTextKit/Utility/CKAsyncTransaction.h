@@ -33,6 +33,22 @@ typedef NS_ENUM(NSUInteger, CKAsyncTransactionState) {
   CKAsyncTransactionStateCanceled,
 };
 
+typedef NS_ENUM(NSUInteger, CKAsyncTransactionOperationPriority) {
+  /** Runs in the order it was added, after any high priority operation waiting on the same queue. */
+  CKAsyncTransactionOperationPriorityDefault = 0,
+  /** Runs before every default priority operation still waiting on the same queue, e.g. to draw visible content. */
+  CKAsyncTransactionOperationPriorityHigh,
+};
+
+/**
+ Cancels a single operation of a transaction, leaving the others untouched. Its completion block is called with canceled
+ set to YES, and its execution block is skipped if it hasn't started yet. Thread safe.
+ */
+@interface CKAsyncTransactionOperationToken : NSObject
+@property (nonatomic, readonly, getter = isCanceled) BOOL canceled;
+- (void)cancel;
+@end
+
 /**
  @summary CKAsyncTransaction provides lightweight transaction semantics for asynchronous operations.
 
@@ -91,6 +107,22 @@ typedef NS_ENUM(NSUInteger, CKAsyncTransactionState) {
                         queue:(dispatch_queue_t)queue
                    completion:(ck_async_transaction_operation_completion_block_t)completion;
 
+/**
+ @summary Adds a synchronous operation to the transaction, to be executed ahead of or after others waiting on the queue.
+
+ @desc Operations added with this method or addOperationWithBlock:queue:completion: don't each occupy a thread of the
+ queue in the order they were added: whenever the queue has a thread available, it runs the highest priority operation
+ still waiting on it.
+
+ @param priority Where the operation goes among those waiting on the same queue.
+ @returns A token to cancel this operation only.
+ @see addOperationWithBlock:queue:completion:
+ */
+- (CKAsyncTransactionOperationToken *)addOperationWithBlock:(ck_async_transaction_operation_block_t)block
+                                                      queue:(dispatch_queue_t)queue
+                                                   priority:(CKAsyncTransactionOperationPriority)priority
+                                                 completion:(ck_async_transaction_operation_completion_block_t)completion;
+
 /**
  @summary Adds an async operation to the transaction.  The execution block will be executed immediately.
 
@@ -109,6 +141,29 @@ typedef NS_ENUM(NSUInteger, CKAsyncTransactionState) {
                              queue:(dispatch_queue_t)queue
                         completion:(ck_async_transaction_operation_completion_block_t)completion;
 
+/**
+ @summary Adds an operation whose work is carried out by the caller, without dispatching anything.
+
+ @desc Useful when the work for many operations is batched and scheduled elsewhere. Like the completeOperationBlock of
+ async operations, the returned block MUST be called exactly once, from any thread, with the operation's value, or the
+ transaction will never complete.
+
+ @param completion The completion block that will be executed with the value passed to the returned block when all of
+ the operations in the transaction are completed. Executed and released on callbackQueue.
+ */
+- (ck_async_transaction_complete_async_operation_block_t)addExternalOperationWithCompletion:(ck_async_transaction_operation_completion_block_t)completion;
+
+/**
+ @summary Adds an operation whose work is carried out by the caller, and that can be canceled on its own.
+
+ @desc The caller is expected to check the token before doing the work, and may skip it if canceled; the returned block
+ must be called either way.
+
+ @param token Cancels this operation only: its completion block is then called with canceled set to YES.
+ @see addExternalOperationWithCompletion:
+ */
+- (ck_async_transaction_complete_async_operation_block_t)addExternalOperationWithToken:(CKAsyncTransactionOperationToken *)token
+                                                                            completion:(ck_async_transaction_operation_completion_block_t)completion;
 
 /**
  @summary Adds a block to run on the completion of the async transaction.
@@ -142,4 +197,18 @@ typedef NS_ENUM(NSUInteger, CKAsyncTransactionState) {
 
 @end
 
+struct CKAsyncTransactionOperationStatistics {
+  /** Synchronous operations whose execution block ran. */
+  NSUInteger executed;
+  /** Synchronous operations skipped because they or their transaction were canceled before they started. */
+  NSUInteger canceled;
+  /** Time spent in execution blocks, in seconds. */
+  CFTimeInterval executionDuration;
+  /** The canceled operations multiplied by the average duration of the executed ones, in seconds. */
+  CFTimeInterval estimatedSavedDuration;
+};
+
+/** Totals for all synchronous operations of all transactions so far. */
+CKAsyncTransactionOperationStatistics CKAsyncTransactionGetOperationStatistics();
+
 #endif
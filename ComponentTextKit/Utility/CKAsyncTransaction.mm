@@ -10,12 +10,111 @@
 
 #import <ComponentTextKit/CKAsyncTransaction.h>
 
+#import <atomic>
+#import <deque>
+#import <mutex>
+#import <unordered_map>
+
+#import <QuartzCore/QuartzCore.h>
+
 #import <RenderCore/RCAssert.h>
 
+namespace {
+  /** Operations waiting for a thread of one dispatch queue, by priority, each in the order they were added. */
+  struct PendingOperations {
+    std::mutex mutex; // protects operations
+    std::deque<dispatch_block_t> operations[CKAsyncTransactionOperationPriorityHigh + 1];
+  };
+}
+
+static std::mutex statisticsMutex; // protects statistics
+static CKAsyncTransactionOperationStatistics statistics;
+
+static PendingOperations &pendingOperationsForQueue(dispatch_queue_t queue)
+{
+  // Only a handful of queues are ever used for operations, so their entries are never removed.
+  static std::mutex mutex;
+  static auto *pendingOperationsByQueue = new std::unordered_map<void *, PendingOperations *>();
+  std::lock_guard<std::mutex> l(mutex);
+  auto &pendingOperations = (*pendingOperationsByQueue)[(__bridge void *)queue];
+  if (pendingOperations == nullptr) {
+    pendingOperations = new PendingOperations();
+  }
+  return *pendingOperations;
+}
+
+/**
+ Dispatches one block per operation to the queue, but each block runs whichever operation waiting on the queue has the
+ highest priority, so later high priority operations overtake earlier ones.
+ */
+static void enqueueOperation(dispatch_queue_t queue, CKAsyncTransactionOperationPriority priority, dispatch_block_t operation)
+{
+  PendingOperations &pendingOperations = pendingOperationsForQueue(queue);
+  {
+    std::lock_guard<std::mutex> l(pendingOperations.mutex);
+    pendingOperations.operations[priority].push_back(operation);
+  }
+  dispatch_async(queue, ^{
+    dispatch_block_t next;
+    {
+      std::lock_guard<std::mutex> l(pendingOperations.mutex);
+      for (NSInteger p = CKAsyncTransactionOperationPriorityHigh; p >= 0 && next == nil; p--) {
+        auto &operations = pendingOperations.operations[p];
+        if (!operations.empty()) {
+          next = operations.front();
+          operations.pop_front();
+        }
+      }
+    }
+    next();
+  });
+}
+
+static void recordExecutedOperation(CFTimeInterval duration)
+{
+  std::lock_guard<std::mutex> l(statisticsMutex);
+  statistics.executed++;
+  statistics.executionDuration += duration;
+}
+
+static void recordCanceledOperation()
+{
+  std::lock_guard<std::mutex> l(statisticsMutex);
+  statistics.canceled++;
+}
+
+CKAsyncTransactionOperationStatistics CKAsyncTransactionGetOperationStatistics()
+{
+  std::lock_guard<std::mutex> l(statisticsMutex);
+  CKAsyncTransactionOperationStatistics result = statistics;
+  if (result.executed > 0) {
+    result.estimatedSavedDuration = result.canceled * (result.executionDuration / result.executed);
+  }
+  return result;
+}
+
+@implementation CKAsyncTransactionOperationToken
+{
+  std::atomic<bool> _canceled;
+}
+
+- (BOOL)isCanceled
+{
+  return _canceled;
+}
+
+- (void)cancel
+{
+  _canceled = true;
+}
+
+@end
+
 @interface CKAsyncTransactionOperation : NSObject
 - (id)initWithOperationCompletionBlock:(ck_async_transaction_operation_completion_block_t)operationCompletionBlock;
 @property (nonatomic, copy) ck_async_transaction_operation_completion_block_t operationCompletionBlock;
 @property (atomic, retain) id<NSObject> value; // set on bg queue by the operation block
+@property (nonatomic, strong) CKAsyncTransactionOperationToken *token;
 @end
 
 @implementation CKAsyncTransactionOperation
@@ -100,28 +199,72 @@
 - (void)addOperationWithBlock:(ck_async_transaction_operation_block_t)block
                         queue:(dispatch_queue_t)queue
                    completion:(ck_async_transaction_operation_completion_block_t)completion
+{
+  [self addOperationWithBlock:block queue:queue priority:CKAsyncTransactionOperationPriorityDefault completion:completion];
+}
+
+- (CKAsyncTransactionOperationToken *)addOperationWithBlock:(ck_async_transaction_operation_block_t)block
+                                                      queue:(dispatch_queue_t)queue
+                                                   priority:(CKAsyncTransactionOperationPriority)priority
+                                                 completion:(ck_async_transaction_operation_completion_block_t)completion
 {
   RCAssertMainThread();
   RCAssert(_state == CKAsyncTransactionStateOpen, @"You can only add operations to open transactions");
 
   [self _ensureTransactionData];
 
+  CKAsyncTransactionOperationToken *token = [CKAsyncTransactionOperationToken new];
   CKAsyncTransactionOperation *operation = [[CKAsyncTransactionOperation alloc] initWithOperationCompletionBlock:completion];
+  operation.token = token;
   [_operations addObject:operation];
-  dispatch_group_async(_group, queue, ^{
-    if (self->_state != CKAsyncTransactionStateCanceled) {
+  dispatch_group_t group = _group;
+  dispatch_group_enter(group);
+  enqueueOperation(queue, priority, ^{
+    if (self->_state == CKAsyncTransactionStateCanceled || token.isCanceled) {
+      recordCanceledOperation();
+    } else {
+      const CFTimeInterval start = CACurrentMediaTime();
       operation.value = block();
+      recordExecutedOperation(CACurrentMediaTime() - start);
     }
+    dispatch_group_leave(group);
   });
+  return token;
+}
+
+- (ck_async_transaction_complete_async_operation_block_t)addExternalOperationWithCompletion:(ck_async_transaction_operation_completion_block_t)completion
+{
+  return [self addExternalOperationWithToken:nil completion:completion];
+}
+
+- (ck_async_transaction_complete_async_operation_block_t)addExternalOperationWithToken:(CKAsyncTransactionOperationToken *)token
+                                                                            completion:(ck_async_transaction_operation_completion_block_t)completion
+{
+  RCAssertMainThread();
+  RCAssert(_state == CKAsyncTransactionStateOpen, @"You can only add operations to open transactions");
+
+  [self _ensureTransactionData];
+
+  CKAsyncTransactionOperation *operation = [[CKAsyncTransactionOperation alloc] initWithOperationCompletionBlock:completion];
+  operation.token = token;
+  [_operations addObject:operation];
+  dispatch_group_t group = _group;
+  dispatch_group_enter(group);
+  return ^(id<NSObject> value){
+    operation.value = value;
+    dispatch_group_leave(group);
+  };
 }
 
 - (void)addCompletionBlock:(ck_async_transaction_completion_block_t)completion
 {
   __weak __typeof(self) weakSelf = self;
-  [self addOperationWithBlock:^(){return (id<NSObject>)nil;} queue:_callbackQueue completion:^(id<NSObject> value, BOOL canceled) {
+  // Not a synchronous operation: nothing needs to run before the completion, nor to be counted in the statistics.
+  ck_async_transaction_complete_async_operation_block_t complete = [self addExternalOperationWithCompletion:^(id<NSObject> value, BOOL canceled) {
     __typeof(self) strongSelf = weakSelf;
     completion(strongSelf, canceled);
   }];
+  complete(nil);
 }
 
 - (void)cancel
@@ -147,7 +290,7 @@
     dispatch_group_notify(_group, _callbackQueue, ^{
       BOOL isCanceled = (self->_state == CKAsyncTransactionStateCanceled);
       for (CKAsyncTransactionOperation *operation in self->_operations) {
-        [operation callAndReleaseCompletionBlock:isCanceled];
+        [operation callAndReleaseCompletionBlock:isCanceled || operation.token.isCanceled];
       }
       if (self->_completionBlock) {
         self->_completionBlock(self, isCanceled);
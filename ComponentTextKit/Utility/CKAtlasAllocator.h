@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <ComponentKit/CKDefines.h>
+
+#if CK_NOT_SWIFT
+
+#import <vector>
+
+#import <Foundation/Foundation.h>
+
+namespace CK {
+
+  /**
+   Packs rectangles into a bounded number of equally sized pages, in rows ("shelves") of similar heights laid out from
+   the top of each page.
+
+   Rectangles are never freed one by one. Once every page is full, the least recently used page is emptied as a whole
+   and reused, and the identifiers of the allocations it held are handed back as evicted. This only does bookkeeping in
+   integer units (typically pixels); what is stored in the pages is up to the caller.
+   */
+  class AtlasAllocator {
+  public:
+    struct Allocation {
+      NSUInteger identifier;
+      NSUInteger page;
+      NSUInteger x;
+      NSUInteger y;
+      NSUInteger width;
+      NSUInteger height;
+    };
+
+    AtlasAllocator(NSUInteger pageWidth, NSUInteger pageHeight, NSUInteger maximumPageCount) noexcept;
+
+    /**
+     Finds room for a rectangle of the given size, evicting the least recently used page if needed.
+
+     @param evicted Identifiers of the allocations that were evicted to make room are appended to this.
+     @return false if the size is empty or can never fit in a page.
+     */
+    bool allocate(NSUInteger width, NSUInteger height, Allocation &allocation, std::vector<NSUInteger> &evicted) noexcept;
+
+    /** Marks a page as recently used, making it the last one to be evicted. */
+    void touch(NSUInteger page) noexcept;
+
+    /** Stops allocating in a page, even if it has room left, until it is evicted. */
+    void seal(NSUInteger page) noexcept;
+
+    /** Empties every page. */
+    void clear() noexcept;
+
+    NSUInteger pageCount() const noexcept { return _pages.size(); }
+    NSUInteger pageWidth() const noexcept { return _pageWidth; }
+    NSUInteger pageHeight() const noexcept { return _pageHeight; }
+
+  private:
+    struct Shelf {
+      NSUInteger y;
+      NSUInteger height;
+      NSUInteger usedWidth;
+    };
+
+    struct Page {
+      std::vector<Shelf> shelves;
+      NSUInteger usedHeight;
+      std::vector<NSUInteger> allocations;
+      NSUInteger lastUse;
+      bool sealed;
+    };
+
+    bool allocateInPage(NSUInteger pageIndex, NSUInteger width, NSUInteger height, Allocation &allocation) noexcept;
+
+    const NSUInteger _pageWidth;
+    const NSUInteger _pageHeight;
+    const NSUInteger _maximumPageCount;
+    std::vector<Page> _pages;
+    NSUInteger _clock;
+    NSUInteger _nextIdentifier;
+  };
+
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import "CKAtlasAllocator.h"
+
+namespace CK {
+
+  AtlasAllocator::AtlasAllocator(NSUInteger pageWidth, NSUInteger pageHeight, NSUInteger maximumPageCount) noexcept
+  : _pageWidth(pageWidth), _pageHeight(pageHeight), _maximumPageCount(maximumPageCount), _clock(0), _nextIdentifier(0) {}
+
+  bool AtlasAllocator::allocateInPage(NSUInteger pageIndex, NSUInteger width, NSUInteger height, Allocation &allocation) noexcept
+  {
+    auto &page = _pages[pageIndex];
+    if (page.sealed) {
+      return false;
+    }
+
+    // Use the lowest shelf the rectangle fits in, as long as it doesn't waste more than half the rectangle's height.
+    Shelf *bestShelf = nullptr;
+    for (auto &shelf : page.shelves) {
+      if (shelf.height >= height
+          && shelf.height <= height + height / 2
+          && _pageWidth - shelf.usedWidth >= width
+          && (bestShelf == nullptr || shelf.height < bestShelf->height)) {
+        bestShelf = &shelf;
+      }
+    }
+    if (bestShelf == nullptr) {
+      if (_pageHeight - page.usedHeight < height) {
+        return false;
+      }
+      page.shelves.push_back({page.usedHeight, height, 0});
+      page.usedHeight += height;
+      bestShelf = &page.shelves.back();
+    }
+
+    allocation = {_nextIdentifier++, pageIndex, bestShelf->usedWidth, bestShelf->y, width, height};
+    bestShelf->usedWidth += width;
+    page.allocations.push_back(allocation.identifier);
+    touch(pageIndex);
+    return true;
+  }
+
+  bool AtlasAllocator::allocate(NSUInteger width, NSUInteger height, Allocation &allocation, std::vector<NSUInteger> &evicted) noexcept
+  {
+    if (width == 0 || height == 0 || width > _pageWidth || height > _pageHeight || _maximumPageCount == 0) {
+      return false;
+    }
+
+    for (NSUInteger i = 0; i < _pages.size(); i++) {
+      if (allocateInPage(i, width, height, allocation)) {
+        return true;
+      }
+    }
+
+    if (_pages.size() < _maximumPageCount) {
+      _pages.push_back({});
+      return allocateInPage(_pages.size() - 1, width, height, allocation);
+    }
+
+    NSUInteger leastRecentlyUsedPage = 0;
+    for (NSUInteger i = 1; i < _pages.size(); i++) {
+      if (_pages[i].lastUse < _pages[leastRecentlyUsedPage].lastUse) {
+        leastRecentlyUsedPage = i;
+      }
+    }
+    auto &page = _pages[leastRecentlyUsedPage];
+    evicted.insert(evicted.end(), page.allocations.begin(), page.allocations.end());
+    page = {};
+    return allocateInPage(leastRecentlyUsedPage, width, height, allocation);
+  }
+
+  void AtlasAllocator::touch(NSUInteger page) noexcept
+  {
+    if (page < _pages.size()) {
+      _pages[page].lastUse = ++_clock;
+    }
+  }
+
+  void AtlasAllocator::seal(NSUInteger page) noexcept
+  {
+    if (page < _pages.size()) {
+      _pages[page].sealed = true;
+    }
+  }
+
+  void AtlasAllocator::clear() noexcept
+  {
+    _pages.clear();
+  }
+
+}
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <ComponentKit/CKDefines.h>
+
+#if CK_NOT_SWIFT
+
+#import <map>
+#import <mutex>
+#import <vector>
+
+#import <UIKit/UIKit.h>
+
+#import <ComponentTextKit/CKTextKitRendererCache.h>
+
+namespace CK {
+
+  /**
+   Recycles the pixel buffers, and the bitmap contexts drawing into them, that async displays rasterize into.
+
+   Images are made from a bitmap without copying its pixels: the buffer stays with the image, and only comes back to the
+   pool once the image is released, e.g. when a layer's contents are replaced. Idle buffers are bucketed by capacity so a
+   buffer can be reused for any bitmap a little smaller than it, kept up to a byte limit, and freed on memory warnings and
+   when the app enters the background. Safe to use from any thread.
+   */
+  class BitmapContextPool {
+  public:
+    struct Bitmap {
+      void *data;
+      size_t capacity;
+      /** Created lazily over data and kept as long as the bitmaps drawn into the buffer have the same format. */
+      CGContextRef context;
+      size_t width;
+      size_t height;
+      size_t bytesPerRow;
+      CGBitmapInfo bitmapInfo;
+      BitmapContextPool *pool;
+    };
+
+    struct Statistics {
+      /** Buffers allocated because no idle buffer was big enough. */
+      NSUInteger allocations;
+      /** Bitmaps that reused an idle buffer. */
+      NSUInteger reuses;
+      /** Bytes held by idle buffers. */
+      NSUInteger idleBytes;
+    };
+
+    BitmapContextPool(size_t maximumIdleBytes);
+    ~BitmapContextPool();
+
+    /**
+     Returns a bitmap whose context draws in points, flipped like UIGraphicsBeginImageContextWithOptions, or nullptr if it
+     can't be allocated.
+
+     @param coversEveryPixel Whether the caller will fill the whole bitmap with an opaque color before drawing. Reused
+     buffers are only cleared, and new ones only zero-filled, when it doesn't.
+     */
+    Bitmap *checkOut(CGSize size, CGFloat scale, BOOL opaque, BOOL coversEveryPixel);
+
+    /** Returns a +1 image backed by the bitmap's buffer. The bitmap must not be used afterwards. */
+    CGImageRef createImage(Bitmap *bitmap);
+
+    /** Gives back a bitmap that no image was created from. */
+    void checkIn(Bitmap *bitmap);
+
+    /** Frees every idle buffer. */
+    void trim();
+
+    Statistics statistics();
+
+  private:
+    void recycle(Bitmap *bitmap);
+    static void releaseImageData(void *info, const void *data, size_t size);
+
+    const size_t _maximumIdleBytes;
+    CGColorSpaceRef _colorSpace;
+    std::mutex _mutex; // protects everything below
+    std::multimap<size_t, Bitmap *> _idleBitmapsByCapacity;
+    Statistics _statistics;
+    TextKit::ApplicationObserver *_applicationObserver;
+  };
+
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import "CKBitmapContextPool.h"
+
+#import <cstdlib>
+#import <cstring>
+
+static const size_t kPageSize = 4096;
+
+/** Page multiples up to 64KB, then steps of an eighth of the power of two below, so buckets stay few but tight. */
+static size_t capacityForBytes(size_t bytes)
+{
+  size_t capacity = (bytes + kPageSize - 1) / kPageSize * kPageSize;
+  if (capacity > 16 * kPageSize) {
+    size_t step = 1;
+    while (step * 2 <= capacity) {
+      step *= 2;
+    }
+    step /= 8;
+    capacity = (capacity + step - 1) / step * step;
+  }
+  return capacity;
+}
+
+static void freeBitmap(CK::BitmapContextPool::Bitmap *bitmap)
+{
+  CGContextRelease(bitmap->context);
+  free(bitmap->data);
+  delete bitmap;
+}
+
+namespace CK {
+
+  BitmapContextPool::BitmapContextPool(size_t maximumIdleBytes)
+  : _maximumIdleBytes(maximumIdleBytes), _colorSpace(CGColorSpaceCreateDeviceRGB()), _statistics({0, 0, 0})
+  {
+    _applicationObserver = new TextKit::ApplicationObserver([this] {
+      trim();
+    }, [this] {
+      trim();
+    });
+  }
+
+  BitmapContextPool::~BitmapContextPool()
+  {
+    delete _applicationObserver;
+    trim();
+    CGColorSpaceRelease(_colorSpace);
+  }
+
+  BitmapContextPool::Bitmap *BitmapContextPool::checkOut(CGSize size, CGFloat scale, BOOL opaque, BOOL coversEveryPixel)
+  {
+    const size_t width = (size_t)ceil(size.width * scale);
+    const size_t height = (size_t)ceil(size.height * scale);
+    if (width == 0 || height == 0) {
+      return nullptr;
+    }
+    // Rows aligned to 64 bytes, as Core Graphics prefers them.
+    const size_t bytesPerRow = (width * 4 + 63) & ~(size_t)63;
+    const size_t byteCount = bytesPerRow * height;
+    const CGBitmapInfo bitmapInfo =
+    (opaque ? kCGImageAlphaNoneSkipFirst : kCGImageAlphaPremultipliedFirst) | kCGBitmapByteOrder32Host;
+
+    Bitmap *bitmap = nullptr;
+    {
+      std::lock_guard<std::mutex> l(_mutex);
+      // Don't let a small bitmap tie up a much bigger buffer.
+      const auto it = _idleBitmapsByCapacity.lower_bound(byteCount);
+      if (it != _idleBitmapsByCapacity.end() && it->first <= byteCount + byteCount / 4) {
+        bitmap = it->second;
+        _idleBitmapsByCapacity.erase(it);
+        _statistics.idleBytes -= bitmap->capacity;
+        _statistics.reuses++;
+      } else {
+        _statistics.allocations++;
+      }
+    }
+
+    if (bitmap == nullptr) {
+      const size_t capacity = capacityForBytes(byteCount);
+      // Fresh pages from calloc are zero-filled by the kernel for free; malloc avoids clearing small ones needlessly.
+      void *data = coversEveryPixel ? malloc(capacity) : calloc(1, capacity);
+      if (data == nullptr) {
+        return nullptr;
+      }
+      bitmap = new Bitmap{data, capacity, NULL, 0, 0, 0, 0, this};
+    } else if (!coversEveryPixel) {
+      memset(bitmap->data, 0, byteCount);
+    }
+
+    if (bitmap->context == NULL
+        || bitmap->width != width
+        || bitmap->height != height
+        || bitmap->bytesPerRow != bytesPerRow
+        || bitmap->bitmapInfo != bitmapInfo) {
+      CGContextRelease(bitmap->context);
+      bitmap->context = CGBitmapContextCreate(bitmap->data, width, height, 8, bytesPerRow, _colorSpace, bitmapInfo);
+      bitmap->width = width;
+      bitmap->height = height;
+      bitmap->bytesPerRow = bytesPerRow;
+      bitmap->bitmapInfo = bitmapInfo;
+      if (bitmap->context == NULL) {
+        freeBitmap(bitmap);
+        return nullptr;
+      }
+    }
+
+    // Undone when the bitmap is turned into an image or checked in, so the context can be reused as is.
+    CGContextSaveGState(bitmap->context);
+    CGContextTranslateCTM(bitmap->context, 0, height);
+    CGContextScaleCTM(bitmap->context, scale, -scale);
+    return bitmap;
+  }
+
+  CGImageRef BitmapContextPool::createImage(Bitmap *bitmap)
+  {
+    CGContextRestoreGState(bitmap->context);
+    // The provider hands the bitmap back to the pool when the image, and so the provider, is released.
+    CGDataProviderRef provider =
+    CGDataProviderCreateWithData(bitmap, bitmap->data, bitmap->bytesPerRow * bitmap->height, &releaseImageData);
+    CGImageRef image = CGImageCreate(bitmap->width,
+                                     bitmap->height,
+                                     8,
+                                     32,
+                                     bitmap->bytesPerRow,
+                                     _colorSpace,
+                                     bitmap->bitmapInfo,
+                                     provider,
+                                     NULL,
+                                     false,
+                                     kCGRenderingIntentDefault);
+    CGDataProviderRelease(provider);
+    return image;
+  }
+
+  void BitmapContextPool::checkIn(Bitmap *bitmap)
+  {
+    CGContextRestoreGState(bitmap->context);
+    recycle(bitmap);
+  }
+
+  void BitmapContextPool::releaseImageData(void *info, const void *data, size_t size)
+  {
+    Bitmap *bitmap = (Bitmap *)info;
+    bitmap->pool->recycle(bitmap);
+  }
+
+  void BitmapContextPool::recycle(Bitmap *bitmap)
+  {
+    {
+      std::lock_guard<std::mutex> l(_mutex);
+      if (_statistics.idleBytes + bitmap->capacity <= _maximumIdleBytes) {
+        _idleBitmapsByCapacity.emplace(bitmap->capacity, bitmap);
+        _statistics.idleBytes += bitmap->capacity;
+        return;
+      }
+    }
+    freeBitmap(bitmap);
+  }
+
+  void BitmapContextPool::trim()
+  {
+    std::multimap<size_t, Bitmap *> idleBitmaps;
+    {
+      std::lock_guard<std::mutex> l(_mutex);
+      std::swap(idleBitmaps, _idleBitmapsByCapacity);
+      _statistics.idleBytes = 0;
+    }
+    for (const auto &it : idleBitmaps) {
+      freeBitmap(it.second);
+    }
+  }
+
+  BitmapContextPool::Statistics BitmapContextPool::statistics()
+  {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _statistics;
+  }
+
+}
@@ -143,10 +143,20 @@ namespace CK {
     NSUInteger getMaxCost() const { return _maxCost; }
     std::size_t count() const { return _keysToItems.size(); }
     NSUInteger totalCost() const { return getCurrentCost(); }
+    /** Highest total cost reached, counting items inserted right before a compaction evicted others. */
+    NSUInteger peakCost() const { return _peakCost; }
     CGFloat compactionFactor() const { return _compactionFactor; }
+    NSUInteger hitCount() const { return _hit; }
+    NSUInteger missCount() const { return _miss; }
 
     void setCompactionFactor(CGFloat newFactor) { _compactionFactor = newFactor; }
 
+    void setMaxCost(NSUInteger maxCost)
+    {
+      _maxCost = maxCost;
+      _compactIfNeeded();
+    }
+
     void removeAllObjects()
     {
       _keysToItems.clear();
@@ -180,6 +190,7 @@ namespace CK {
     {
       onInsertItem(key, cost);
       _keysToItems[key] = value;
+      _peakCost = std::max(_peakCost, getCurrentCost());
       _compactIfNeeded();
     }
 
@@ -221,6 +232,8 @@ namespace CK {
     NSUInteger _hit = 0;
     NSUInteger _miss = 0;
 
+    NSUInteger _peakCost = 0;
+
     CGFloat _compactionFactor;
 
     // Customization for strategies (template method pattern). Implemented in derived classes with concrete strategies
@@ -610,6 +623,31 @@ namespace CK {
       std::lock_guard<lockPolicy> lg(_l);
       _cacheImpl.removeAllObjects();
     }
+    void setMaxCost(NSUInteger maxCost)
+    {
+      std::lock_guard<lockPolicy> lg(_l);
+      _cacheImpl.setMaxCost(maxCost);
+    }
+    NSUInteger totalCost()
+    {
+      std::lock_guard<lockPolicy> lg(_l);
+      return _cacheImpl.totalCost();
+    }
+    NSUInteger peakCost()
+    {
+      std::lock_guard<lockPolicy> lg(_l);
+      return _cacheImpl.peakCost();
+    }
+    NSUInteger hitCount()
+    {
+      std::lock_guard<lockPolicy> lg(_l);
+      return _cacheImpl.hitCount();
+    }
+    NSUInteger missCount()
+    {
+      std::lock_guard<lockPolicy> lg(_l);
+      return _cacheImpl.missCount();
+    }
     //constructors
     template <typename ...StrategyArgs>
     ConcurrentCacheImpl(StrategyArgs&&... args) : _cacheImpl(std::forward<StrategyArgs>(args)...)
@@ -0,0 +1,153 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <mutex>
+
+#import <ComponentTextKit/CKAsyncLayer.h>
+
+@interface CKAsyncDisplayBatcherTestsLayer : CKAsyncLayer
+@end
+
+@implementation CKAsyncDisplayBatcherTestsLayer
+
++ (void)drawInContext:(CGContextRef)context parameters:(NSObject *)parameters
+{
+  CGContextSetFillColorWithColor(context, [UIColor redColor].CGColor);
+  CGContextFillRect(context, CGRectMake(0, 0, 1, 1));
+}
+
+@end
+
+static std::mutex drawOrderMutex;
+static NSMutableArray<NSNumber *> *drawOrder;
+
+/** Records the order its displays are drawn in. */
+@interface CKAsyncDisplayBatcherTestsOrderedLayer : CKAsyncLayer
+@property (nonatomic, assign) NSUInteger index;
+@end
+
+@implementation CKAsyncDisplayBatcherTestsOrderedLayer
+
+- (NSObject *)drawParameters
+{
+  return @(_index);
+}
+
++ (void)drawInContext:(CGContextRef)context parameters:(NSObject *)parameters
+{
+  std::lock_guard<std::mutex> l(drawOrderMutex);
+  [drawOrder addObject:(NSNumber *)parameters];
+}
+
+@end
+
+@interface CKAsyncDisplayBatcherTests : XCTestCase
+@end
+
+@implementation CKAsyncDisplayBatcherTests
+
+- (void)tearDown
+{
+  CKAsyncLayerSetBatchedDisplayEnabled(NO);
+  [super tearDown];
+}
+
+- (void)testLayersDisplayedDuringTheSameRunLoopTurnAreDrawnInOneBatchPerSize
+{
+  CKAsyncLayerSetBatchedDisplayEnabled(YES);
+  const CKAsyncLayerBatchedDisplayStatistics before = CKAsyncLayerGetBatchedDisplayStatistics();
+
+  NSMutableArray<CKAsyncLayer *> *layers = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 30; i++) {
+    CKAsyncLayer *layer = [CKAsyncDisplayBatcherTestsLayer layer];
+    layer.displayMode = CKAsyncLayerDisplayModeAlwaysAsync;
+    layer.contentsScale = 2;
+    // Three sizes, so three groups of displays that can share a bitmap context.
+    layer.bounds = CGRectMake(0, 0, 20 + 10 * (i % 3), 10);
+    [layer setNeedsDisplay];
+    [layer displayIfNeeded];
+    [layers addObject:layer];
+  }
+
+  NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+  while ([[layers filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"contents == nil"]] count] > 0
+         && [timeout timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  }
+
+  for (CKAsyncLayer *layer in layers) {
+    XCTAssertNotNil(layer.contents);
+    XCTAssertEqual(CGImageGetWidth((__bridge CGImageRef)layer.contents), (size_t)(layer.bounds.size.width * 2));
+  }
+  const CKAsyncLayerBatchedDisplayStatistics after = CKAsyncLayerGetBatchedDisplayStatistics();
+  XCTAssertEqual(after.batches - before.batches, 1u);
+  XCTAssertEqual(after.displays - before.displays, 30u);
+  XCTAssertLessThanOrEqual(after.dispatches - before.dispatches, 3u);
+}
+
+- (void)testHighPriorityDisplaysAreDrawnBeforeTheOthersOfTheirBatch
+{
+  CKAsyncLayerSetBatchedDisplayEnabled(YES);
+  drawOrder = [NSMutableArray array];
+
+  NSMutableArray<CKAsyncLayer *> *layers = [NSMutableArray array];
+  for (NSUInteger i = 0; i < 20; i++) {
+    CKAsyncDisplayBatcherTestsOrderedLayer *layer = [CKAsyncDisplayBatcherTestsOrderedLayer layer];
+    layer.index = i;
+    layer.displayMode = CKAsyncLayerDisplayModeAlwaysAsync;
+    // Displayed after the default priority ones they follow, yet drawn first.
+    layer.displayPriority = (i % 2 == 1) ? CKAsyncTransactionOperationPriorityHigh : CKAsyncTransactionOperationPriorityDefault;
+    layer.bounds = CGRectMake(0, 0, 20, 10);
+    [layer setNeedsDisplay];
+    [layer displayIfNeeded];
+    [layers addObject:layer];
+  }
+
+  NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+  while ([[layers filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"hasPendingAsyncDisplay == YES"]] count] > 0
+         && [timeout timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  }
+
+  std::lock_guard<std::mutex> l(drawOrderMutex);
+  XCTAssertEqual(drawOrder.count, 20u);
+  for (NSUInteger i = 0; i < drawOrder.count; i++) {
+    XCTAssertEqual(drawOrder[i].unsignedIntegerValue % 2, (NSUInteger)(i < 10 ? 1 : 0), @"%@", drawOrder);
+  }
+}
+
+- (void)testCancelingABatchedDisplaySkipsItsDrawing
+{
+  CKAsyncLayerSetBatchedDisplayEnabled(YES);
+  drawOrder = [NSMutableArray array];
+
+  CKAsyncDisplayBatcherTestsOrderedLayer *layer = [CKAsyncDisplayBatcherTestsOrderedLayer layer];
+  layer.displayMode = CKAsyncLayerDisplayModeAlwaysAsync;
+  layer.bounds = CGRectMake(0, 0, 20, 10);
+  [layer setNeedsDisplay];
+  [layer displayIfNeeded];
+  XCTAssertTrue(layer.hasPendingAsyncDisplay);
+  [layer cancelAsyncDisplay];
+  XCTAssertFalse(layer.hasPendingAsyncDisplay);
+
+  const CKAsyncLayerBatchedDisplayStatistics before = CKAsyncLayerGetBatchedDisplayStatistics();
+  NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+  while (CKAsyncLayerGetBatchedDisplayStatistics().batches == before.batches && [timeout timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  }
+
+  std::lock_guard<std::mutex> l(drawOrderMutex);
+  XCTAssertEqual(drawOrder.count, 0u);
+  XCTAssertNil(layer.contents);
+}
+
+@end
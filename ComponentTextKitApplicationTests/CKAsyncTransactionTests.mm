@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <ComponentTextKit/CKAsyncTransaction.h>
+
+@interface CKAsyncTransactionTests : XCTestCase
+@end
+
+@implementation CKAsyncTransactionTests
+
+- (void)testHighPriorityOperationsOvertakeDefaultPriorityOperationsWaitingOnTheSameQueue
+{
+  dispatch_queue_t queue = dispatch_queue_create("CKAsyncTransactionTests", DISPATCH_QUEUE_SERIAL);
+  // Hold the queue until every operation has been added.
+  dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+  dispatch_async(queue, ^{
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+  });
+
+  NSMutableArray<NSString *> *order = [NSMutableArray array];
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Transaction completed"];
+  CKAsyncTransaction *transaction =
+  [[CKAsyncTransaction alloc] initWithCallbackQueue:dispatch_get_main_queue()
+                                    completionBlock:^(CKAsyncTransaction *completedTransaction, BOOL canceled) {
+                                      [expectation fulfill];
+                                    }];
+  for (NSString *name in @[@"default 1", @"default 2"]) {
+    [transaction addOperationWithBlock:^id{ @synchronized (order) { [order addObject:name]; } return nil; }
+                                 queue:queue
+                              priority:CKAsyncTransactionOperationPriorityDefault
+                            completion:^(id<NSObject> value, BOOL canceled) {}];
+  }
+  [transaction addOperationWithBlock:^id{ @synchronized (order) { [order addObject:@"high"]; } return nil; }
+                               queue:queue
+                            priority:CKAsyncTransactionOperationPriorityHigh
+                          completion:^(id<NSObject> value, BOOL canceled) {}];
+  [transaction commit];
+  dispatch_semaphore_signal(semaphore);
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertEqualObjects(order, (@[@"high", @"default 1", @"default 2"]));
+}
+
+- (void)testCanceledOperationIsSkippedAndOthersStillRun
+{
+  dispatch_queue_t queue = dispatch_queue_create("CKAsyncTransactionTests", DISPATCH_QUEUE_SERIAL);
+  dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+  dispatch_async(queue, ^{
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+  });
+  const CKAsyncTransactionOperationStatistics before = CKAsyncTransactionGetOperationStatistics();
+
+  __block BOOL canceledOperationRan = NO;
+  __block BOOL canceledOperationCompletedAsCanceled = NO;
+  __block id<NSObject> otherValue = nil;
+  XCTestExpectation *expectation = [self expectationWithDescription:@"Transaction completed"];
+  CKAsyncTransaction *transaction =
+  [[CKAsyncTransaction alloc] initWithCallbackQueue:dispatch_get_main_queue()
+                                    completionBlock:^(CKAsyncTransaction *completedTransaction, BOOL canceled) {
+                                      [expectation fulfill];
+                                    }];
+  CKAsyncTransactionOperationToken *token =
+  [transaction addOperationWithBlock:^id{ canceledOperationRan = YES; return @1; }
+                               queue:queue
+                            priority:CKAsyncTransactionOperationPriorityDefault
+                          completion:^(id<NSObject> value, BOOL canceled) {
+                            canceledOperationCompletedAsCanceled = canceled;
+                          }];
+  [transaction addOperationWithBlock:^id{ return @2; }
+                               queue:queue
+                          completion:^(id<NSObject> value, BOOL canceled) {
+                            otherValue = value;
+                          }];
+  [transaction commit];
+  [token cancel];
+  dispatch_semaphore_signal(semaphore);
+
+  [self waitForExpectationsWithTimeout:5 handler:nil];
+  XCTAssertFalse(canceledOperationRan);
+  XCTAssertTrue(canceledOperationCompletedAsCanceled);
+  XCTAssertEqualObjects(otherValue, @2);
+  const CKAsyncTransactionOperationStatistics after = CKAsyncTransactionGetOperationStatistics();
+  XCTAssertEqual(after.canceled - before.canceled, 1u);
+}
+
+@end
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <vector>
+
+#import <ComponentTextKit/CKAtlasAllocator.h>
+
+@interface CKAtlasAllocatorTests : XCTestCase
+@end
+
+@implementation CKAtlasAllocatorTests
+
+static bool overlap(const CK::AtlasAllocator::Allocation &a, const CK::AtlasAllocator::Allocation &b)
+{
+  return a.page == b.page
+  && a.x < b.x + b.width && b.x < a.x + a.width
+  && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+- (void)testRectanglesArePackedIntoShelvesWithoutOverlapping
+{
+  CK::AtlasAllocator allocator(100, 100, 1);
+  std::vector<CK::AtlasAllocator::Allocation> allocations;
+  std::vector<NSUInteger> evicted;
+  // Three rows of four 25x20 rectangles, and 22 tall ones that fit in the same shelves.
+  for (NSUInteger i = 0; i < 12; i++) {
+    CK::AtlasAllocator::Allocation allocation;
+    XCTAssertTrue(allocator.allocate(25, (i % 2 == 0) ? 20 : 22, allocation, evicted));
+    allocations.push_back(allocation);
+  }
+
+  XCTAssertTrue(evicted.empty());
+  XCTAssertEqual(allocator.pageCount(), 1u);
+  for (size_t i = 0; i < allocations.size(); i++) {
+    XCTAssertLessThanOrEqual(allocations[i].x + allocations[i].width, 100u);
+    XCTAssertLessThanOrEqual(allocations[i].y + allocations[i].height, 100u);
+    for (size_t j = i + 1; j < allocations.size(); j++) {
+      XCTAssertFalse(overlap(allocations[i], allocations[j]));
+    }
+  }
+}
+
+- (void)testRectanglesThatCanNeverFitAreRejected
+{
+  CK::AtlasAllocator allocator(100, 100, 2);
+  CK::AtlasAllocator::Allocation allocation;
+  std::vector<NSUInteger> evicted;
+
+  XCTAssertFalse(allocator.allocate(101, 10, allocation, evicted));
+  XCTAssertFalse(allocator.allocate(10, 101, allocation, evicted));
+  XCTAssertFalse(allocator.allocate(0, 10, allocation, evicted));
+  XCTAssertEqual(allocator.pageCount(), 0u);
+}
+
+- (void)testPagesAreAddedUntilTheLimitThenTheLeastRecentlyUsedOneIsEvicted
+{
+  CK::AtlasAllocator allocator(100, 100, 2);
+  std::vector<NSUInteger> evicted;
+
+  CK::AtlasAllocator::Allocation first;
+  XCTAssertTrue(allocator.allocate(100, 100, first, evicted));
+  CK::AtlasAllocator::Allocation second;
+  XCTAssertTrue(allocator.allocate(100, 100, second, evicted));
+  XCTAssertEqual(allocator.pageCount(), 2u);
+  XCTAssertNotEqual(first.page, second.page);
+  XCTAssertTrue(evicted.empty());
+
+  // The first page is now the most recently used, so the second one makes room.
+  allocator.touch(first.page);
+  CK::AtlasAllocator::Allocation third;
+  XCTAssertTrue(allocator.allocate(50, 50, third, evicted));
+
+  XCTAssertEqual(allocator.pageCount(), 2u);
+  XCTAssertEqual(third.page, second.page);
+  XCTAssertTrue(evicted == std::vector<NSUInteger>{second.identifier});
+}
+
+- (void)testClearingEmptiesEveryPage
+{
+  CK::AtlasAllocator allocator(100, 100, 1);
+  std::vector<NSUInteger> evicted;
+  CK::AtlasAllocator::Allocation allocation;
+  XCTAssertTrue(allocator.allocate(100, 100, allocation, evicted));
+
+  allocator.clear();
+
+  XCTAssertEqual(allocator.pageCount(), 0u);
+  XCTAssertTrue(allocator.allocate(100, 100, allocation, evicted));
+  XCTAssertTrue(evicted.empty());
+}
+
+@end
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <ComponentTextKit/CKAsyncLayerInternal.h>
+#import <ComponentTextKit/CKBitmapContextPool.h>
+
+@interface CKBitmapContextPoolTests : XCTestCase
+@end
+
+@implementation CKBitmapContextPoolTests
+
+- (void)testBufferIsReusedOnceTheImageDrawnIntoItIsReleased
+{
+  CK::BitmapContextPool pool(1024 * 1024);
+
+  CK::BitmapContextPool::Bitmap *bitmap = pool.checkOut({100, 20}, 2, NO, NO);
+  CGContextSetFillColorWithColor(bitmap->context, [UIColor redColor].CGColor);
+  CGContextFillRect(bitmap->context, CGRectMake(0, 0, 100, 20));
+  CGImageRef image = pool.createImage(bitmap);
+  XCTAssertEqual(CGImageGetWidth(image), 200u);
+  XCTAssertEqual(CGImageGetHeight(image), 40u);
+  XCTAssertEqual(pool.statistics().idleBytes, 0u, @"The buffer belongs to the image until it is released");
+  CGImageRelease(image);
+  XCTAssertGreaterThan(pool.statistics().idleBytes, 0u);
+
+  // A slightly narrower bitmap fits in the same buffer, and starts out cleared.
+  bitmap = pool.checkOut({98, 20}, 2, NO, NO);
+  const uint32_t *pixels = (const uint32_t *)bitmap->data;
+  XCTAssertEqual(pixels[0], 0u);
+  pool.checkIn(bitmap);
+
+  const auto statistics = pool.statistics();
+  XCTAssertEqual(statistics.allocations, 1u);
+  XCTAssertEqual(statistics.reuses, 1u);
+}
+
+- (void)testOpaqueBackgroundFillsEveryPixelOfAnUnclearedBuffer
+{
+  CK::BitmapContextPool pool(1024 * 1024);
+  UIColor *white = [UIColor whiteColor];
+
+  // Leave a red raster in the buffer the next bitmap reuses without clearing it.
+  CK::BitmapContextPool::Bitmap *bitmap = pool.checkOut({10.5, 10}, 3, YES, YES);
+  CGContextSetFillColorWithColor(bitmap->context, [UIColor redColor].CGColor);
+  CGContextFillRect(bitmap->context, CGRectMake(0, 0, 11, 10));
+  CGImageRelease(pool.createImage(bitmap));
+
+  // Offset bounds and a size that isn't a whole number of pixels both used to leave some of it showing.
+  bitmap = pool.checkOut({10.5, 10}, 3, YES, YES);
+  XCTAssertEqual(pool.statistics().reuses, 1u);
+  CKAsyncLayerFillBackground(bitmap->context, CGRectMake(4, 4, 10.5, 10), YES, white.CGColor);
+  CGContextFlush(bitmap->context);
+  for (size_t y = 0; y < bitmap->height; y++) {
+    const uint32_t *row = (const uint32_t *)((const uint8_t *)bitmap->data + y * bitmap->bytesPerRow);
+    for (size_t x = 0; x < bitmap->width; x++) {
+      XCTAssertEqual(row[x] & 0x00FFFFFF, 0x00FFFFFFu, @"at %zu, %zu", x, y);
+    }
+  }
+  pool.checkIn(bitmap);
+}
+
+- (void)testIdleBuffersAreFreedBeyondTheByteLimitAndWhenTrimmed
+{
+  CK::BitmapContextPool pool(64 * 1024);
+
+  // 100x100 at 1x is 40KB: only one of the two fits under the limit once idle.
+  CK::BitmapContextPool::Bitmap *first = pool.checkOut({100, 100}, 1, YES, YES);
+  CK::BitmapContextPool::Bitmap *second = pool.checkOut({100, 100}, 1, YES, YES);
+  pool.checkIn(first);
+  pool.checkIn(second);
+  XCTAssertLessThanOrEqual(pool.statistics().idleBytes, 64u * 1024u);
+  XCTAssertGreaterThan(pool.statistics().idleBytes, 0u);
+
+  pool.trim();
+  XCTAssertEqual(pool.statistics().idleBytes, 0u);
+}
+
+@end
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <ComponentTextKit/CKTextComponentLayer.h>
+#import <ComponentTextKit/CKTextComponentRasterAtlas.h>
+#import <ComponentTextKit/CKTextKitRenderer.h>
+
+@interface CKTextComponentRasterAtlasTests : XCTestCase
+@end
+
+@implementation CKTextComponentRasterAtlasTests
+
+static CGImageRef createSolidImage(UIColor *color, size_t width, size_t height)
+{
+  CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+  CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace, kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+  CGColorSpaceRelease(colorSpace);
+  CGContextSetFillColorWithColor(context, color.CGColor);
+  CGContextFillRect(context, CGRectMake(0, 0, width, height));
+  CGImageRef image = CGBitmapContextCreateImage(context);
+  CGContextRelease(context);
+  return image;
+}
+
+static NSData *pixelsOfImage(CGImageRef image)
+{
+  const size_t width = CGImageGetWidth(image);
+  const size_t height = CGImageGetHeight(image);
+  NSMutableData *pixels = [NSMutableData dataWithLength:width * height * 4];
+  CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+  CGContextRef context = CGBitmapContextCreate(pixels.mutableBytes, width, height, 8, width * 4, colorSpace, kCGImageAlphaPremultipliedLast);
+  CGColorSpaceRelease(colorSpace);
+  CGContextDrawImage(context, CGRectMake(0, 0, width, height), image);
+  CGContextRelease(context);
+  return pixels;
+}
+
+/** The part of a page image a contentsRect points at. */
+static NSData *pixelsOfContents(id image, CGRect contentsRect)
+{
+  CGImageRef page = (__bridge CGImageRef)image;
+  const CGFloat width = CGImageGetWidth(page);
+  const CGFloat height = CGImageGetHeight(page);
+  CGImageRef part = CGImageCreateWithImageInRect(page, {
+    {contentsRect.origin.x * width, contentsRect.origin.y * height},
+    {contentsRect.size.width * width, contentsRect.size.height * height}
+  });
+  NSData *pixels = pixelsOfImage(part);
+  CGImageRelease(part);
+  return pixels;
+}
+
+- (void)tearDown
+{
+  CKTextComponentLayerSetRasterAtlasEnabled(NO);
+  CKTextComponentLayerRasterAtlas().removeAllObjects();
+  [super tearDown];
+}
+
+- (void)testSealedPageHoldsEachRasterInItsContentsRectWithATransparentGutter
+{
+  // A seal delay long enough that only sealPendingPage seals the page.
+  CK::TextKit::RasterAtlas atlas(64, 1, 60);
+  const CK::TextKit::Renderer::Key redKey({[[NSAttributedString alloc] initWithString:@"red"]}, {20, 10});
+  const CK::TextKit::Renderer::Key blueKey({[[NSAttributedString alloc] initWithString:@"blue"]}, {20, 10});
+  CGImageRef red = createSolidImage([UIColor redColor], 20, 10);
+  CGImageRef blue = createSolidImage([UIColor blueColor], 20, 10);
+
+  atlas.insert(redKey, red);
+  atlas.insert(blueKey, blue);
+  atlas.sealPendingPage();
+
+  const CK::TextKit::AtlasContents redContents = atlas.contentsForKey(redKey);
+  const CK::TextKit::AtlasContents blueContents = atlas.contentsForKey(blueKey);
+  XCTAssertNotNil(redContents.image);
+  XCTAssertEqual(redContents.image, blueContents.image, @"Both rasters should share one page");
+  XCTAssertTrue(CGRectEqualToRect(redContents.contentsRect, CGRectMake(0, 0, 20.0 / 64, 10.0 / 64)));
+  XCTAssertTrue(CGRectEqualToRect(blueContents.contentsRect, CGRectMake(21.0 / 64, 0, 20.0 / 64, 10.0 / 64)));
+  XCTAssertEqualObjects(pixelsOfContents(redContents.image, redContents.contentsRect), pixelsOfImage(red));
+  XCTAssertEqualObjects(pixelsOfContents(blueContents.image, blueContents.contentsRect), pixelsOfImage(blue));
+
+  // The column between them is left transparent.
+  NSData *gutter = pixelsOfContents(redContents.image, CGRectMake(20.0 / 64, 0, 1.0 / 64, 10.0 / 64));
+  const uint8_t *bytes = (const uint8_t *)gutter.bytes;
+  for (NSUInteger i = 0; i < gutter.length; i++) {
+    XCTAssertEqual(bytes[i], 0u);
+  }
+
+  CGImageRelease(red);
+  CGImageRelease(blue);
+}
+
+static CKTextComponentLayer *displayedLayer(CKTextKitRenderer *renderer)
+{
+  CKTextComponentLayer *layer = [CKTextComponentLayer layer];
+  layer.displayMode = CKAsyncLayerDisplayModeAlwaysAsync;
+  layer.contentsScale = 2;
+  layer.bounds = {CGPointZero, renderer.constrainedSize};
+  layer.renderer = renderer;
+  [layer displayIfNeeded];
+
+  NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:5];
+  while (layer.contents == nil && [timeout timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  }
+  return layer;
+}
+
+- (void)testLayerShowsItsTextFromTheAtlasOnceItsPageIsSealed
+{
+  CKTextComponentLayerSetRasterAtlasEnabled(YES);
+  CKTextKitRenderer *renderer =
+  [[CKTextKitRenderer alloc] initWithTextKitAttributes:{[[NSAttributedString alloc] initWithString:@"Atlas"]}
+                                       constrainedSize:{100, 20}];
+
+  // The first display draws the raster and shows it on its own while it is copied into the atlas.
+  CKTextComponentLayer *first = displayedLayer(renderer);
+  XCTAssertNotNil(first.contents);
+  XCTAssertTrue(CGRectEqualToRect(first.contentsRect, CGRectMake(0, 0, 1, 1)));
+  CGImageRef raster = (__bridge CGImageRef)first.contents;
+  XCTAssertEqual(CGImageGetWidth(raster), 200u);
+
+  CKTextComponentLayerRasterAtlas().sealPendingPage();
+
+  CKTextComponentLayer *second = displayedLayer(renderer);
+  CGImageRef page = (__bridge CGImageRef)second.contents;
+  XCTAssertEqual(CGImageGetWidth(page), 512u);
+  XCTAssertEqual(CGImageGetHeight(page), 512u);
+  XCTAssertEqualWithAccuracy(second.contentsRect.size.width, 200.0 / 512, 0.0001);
+  XCTAssertEqualWithAccuracy(second.contentsRect.size.height, 40.0 / 512, 0.0001);
+  XCTAssertEqualObjects(pixelsOfContents(second.contents, second.contentsRect), pixelsOfImage(raster));
+}
+
+@end
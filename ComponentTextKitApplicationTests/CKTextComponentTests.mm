@@ -8,11 +8,17 @@
  *
  */
 
+#import <vector>
+
 #import <UIKit/UIKit.h>
 
 #import <ComponentSnapshotTestCase/CKComponentSnapshotTestCase.h>
 
+#import <ComponentKit/CKComponentSubclass.h>
+#import <ComponentKit/CKInternalHelpers.h>
+
 #import <ComponentTextKit/CKTextComponent.h>
+#import <ComponentTextKit/CKTextKitRenderer.h>
 
 static const CKSizeRange kFlexibleSize = {{0, 0}, {320, 100}};
 
@@ -471,4 +477,68 @@ static NSLayoutManager *testLayoutManagerFactory(void) {
   CKSnapshotVerifyComponent(c, kUnrestrictedSize, @"");
 }
 
+- (void)testLayoutIsComputedOnceFromTheMeasurementCacheForTheSameTextAndConstraint
+{
+  // The string is unique to this test so that no other test has measured it already.
+  NSAttributedString *string = [[NSAttributedString alloc] initWithString:@"Measured once by testLayoutIsComputedOnceFromTheMeasurementCache"];
+  CKTextComponent *c =
+  [CKTextComponent
+   newWithTextAttributes:{
+     .attributedString = string
+   }
+   viewAttributes:{}
+   options:{ }
+   size:{ }];
+
+  const CKTextComponentMeasurementCacheStatistics initialStatistics = CKTextComponentGetMeasurementCacheStatistics();
+  const RCLayout firstLayout = [c layoutThatFits:kFlexibleSize parentSize:kFlexibleSize.max];
+  const RCLayout secondLayout = [c layoutThatFits:kFlexibleSize parentSize:kFlexibleSize.max];
+  const CKTextComponentMeasurementCacheStatistics statistics = CKTextComponentGetMeasurementCacheStatistics();
+
+  XCTAssertEqual(statistics.misses - initialStatistics.misses, 1u);
+  XCTAssertEqual(statistics.hits - initialStatistics.hits, 1u);
+  XCTAssertTrue(CGSizeEqualToSize(firstLayout.size, secondLayout.size));
+
+  CKTextKitRenderer *renderer = [[CKTextKitRenderer alloc] initWithTextKitAttributes:{.attributedString = string}
+                                                                     constrainedSize:kFlexibleSize.max];
+  XCTAssertTrue(CGSizeEqualToSize(firstLayout.size, kFlexibleSize.clamp({
+    CKCeilPixelValue(renderer.size.width),
+    CKCeilPixelValue(renderer.size.height)
+  })));
+}
+
+- (void)testMeasurementsAreReusedAcrossWidthsAtWhichTheTextWrapsTheSameWay
+{
+  // Short enough to fit on one line at every width below, and unique to this test.
+  NSAttributedString *string = [[NSAttributedString alloc] initWithString:@"Rotated and flexed"];
+  CKTextComponent *c =
+  [CKTextComponent
+   newWithTextAttributes:{
+     .attributedString = string
+   }
+   viewAttributes:{}
+   options:{ }
+   size:{ }];
+
+  const CKTextComponentMeasurementCacheStatistics initialStatistics = CKTextComponentGetMeasurementCacheStatistics();
+  // Flexbox measures at a few slightly different widths, then the device rotates to landscape and back.
+  const CGFloat widths[] = {375, 374, 359.5, 667, 375};
+  std::vector<CGSize> sizes;
+  for (const CGFloat width : widths) {
+    sizes.push_back([c layoutThatFits:{{0, 0}, {width, 100}} parentSize:{width, 100}].size);
+  }
+  const CKTextComponentMeasurementCacheStatistics statistics = CKTextComponentGetMeasurementCacheStatistics();
+
+  XCTAssertEqual(statistics.misses - initialStatistics.misses, 1u);
+  XCTAssertEqual(statistics.hits - initialStatistics.hits, 4u);
+  XCTAssertEqual(statistics.rangeHits - initialStatistics.rangeHits, 3u);
+  for (const auto &size : sizes) {
+    XCTAssertTrue(CGSizeEqualToSize(size, sizes[0]));
+  }
+
+  // Too narrow for the text to stay on one line.
+  [c layoutThatFits:{{0, 0}, {20, 100}} parentSize:{20, 100}];
+  XCTAssertEqual(CKTextComponentGetMeasurementCacheStatistics().misses - initialStatistics.misses, 2u);
+}
+
 @end
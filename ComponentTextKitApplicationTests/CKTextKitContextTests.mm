@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <XCTest/XCTest.h>
+
+#import <ComponentTextKit/CKTextKitAttributes.h>
+#import <ComponentTextKit/CKTextKitContext.h>
+#import <ComponentTextKit/CKTextKitRenderer.h>
+
+// Each thread lays out this many different strings in every measured run.
+#define LAYOUTS_PER_THREAD 200
+
+@interface CKTextKitContextTests : XCTestCase
+@end
+
+@implementation CKTextKitContextTests
+
+- (void)testTextKitComponentsAreReusedOnceTheirContextIsDeallocated
+{
+  NSAttributedString *string = [[NSAttributedString alloc] initWithString:@"Reused"];
+  @autoreleasepool {
+    // Make sure at least one stack is idle in the pool.
+    __unused CKTextKitContext *context = [[CKTextKitContext alloc] initWithAttributedString:string
+                                                                              lineBreakMode:NSLineBreakByWordWrapping
+                                                                       maximumNumberOfLines:0
+                                                                            constrainedSize:{100, 100}
+                                                                       layoutManagerFactory:nil];
+  }
+  const CKTextKitContextPoolStatistics initialStatistics = CKTextKitContextGetPoolStatistics();
+
+  CKTextKitContext *context = [[CKTextKitContext alloc] initWithAttributedString:string
+                                                                   lineBreakMode:NSLineBreakByCharWrapping
+                                                            maximumNumberOfLines:2
+                                                                 constrainedSize:{50, 20}
+                                                            layoutManagerFactory:nil];
+  const CKTextKitContextPoolStatistics statistics = CKTextKitContextGetPoolStatistics();
+  XCTAssertEqual(statistics.creations, initialStatistics.creations);
+  XCTAssertEqual(statistics.reuses - initialStatistics.reuses, 1u);
+
+  [context performBlockWithLockedTextKitComponents:^(NSLayoutManager *layoutManager, NSTextStorage *textStorage, NSTextContainer *textContainer) {
+    XCTAssertEqualObjects(textStorage.string, @"Reused");
+    XCTAssertTrue(CGSizeEqualToSize(textContainer.size, CGSizeMake(50, 20)));
+    XCTAssertEqual(textContainer.lineBreakMode, NSLineBreakByCharWrapping);
+    XCTAssertEqual(textContainer.maximumNumberOfLines, 2u);
+  }];
+}
+
+static void layOutTextConcurrently(NSUInteger threadCount)
+{
+  dispatch_group_t group = dispatch_group_create();
+  dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+  for (NSUInteger thread = 0; thread < threadCount; thread++) {
+    dispatch_group_async(group, queue, ^{
+      for (NSUInteger i = 0; i < LAYOUTS_PER_THREAD; i++) {
+        NSString *string = [NSString stringWithFormat:@"Text number %lu laid out on thread %lu", (unsigned long)i, (unsigned long)thread];
+        __unused CKTextKitRenderer *renderer =
+        [[CKTextKitRenderer alloc] initWithTextKitAttributes:{[[NSAttributedString alloc] initWithString:string]}
+                                             constrainedSize:{200, CGFLOAT_MAX}];
+      }
+    });
+  }
+  dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+}
+
+- (void)testPerformanceOfLayingOutTextOnOneThread
+{
+  [self measureBlock:^{
+    layOutTextConcurrently(1);
+  }];
+}
+
+- (void)testPerformanceOfLayingOutTextOnFourThreads
+{
+  [self measureBlock:^{
+    layOutTextConcurrently(4);
+  }];
+}
+
+- (void)testPerformanceOfLayingOutTextOnEightThreads
+{
+  [self measureBlock:^{
+    layOutTextConcurrently(8);
+  }];
+}
+
+@end
@@ -14,6 +14,7 @@
 #import <FBSnapshotTestCase/FBSnapshotTestController.h>
 
 #import <ComponentTextKit/CKTextKitEntityAttribute.h>
+#import <ComponentTextKit/CKTextKitMeasurementCache.h>
 #import <ComponentTextKit/CKTextKitAttributes.h>
 #import <ComponentTextKit/CKTextKitRenderer.h>
 #import <ComponentTextKit/CKTextKitRenderer+Positioning.h>
@@ -155,4 +156,159 @@ static BOOL checkAttributes(const CKTextKitAttributes &attributes, const CGSize
   XCTAssert([renderer rectsForTextRange:NSMakeRange(0, attributedString.length) measureOption:CKTextKitRendererMeasureOptionBlock].count > 0);
 }
 
+- (void)testEstimatedByteCostGrowsWithTheAmountOfText
+{
+  NSString *post = [@"" stringByPaddingToLength:5000 withString:@"A long post that wraps over many lines. " startingAtIndex:0];
+  CKTextKitRenderer *postRenderer =
+  [[CKTextKitRenderer alloc]
+   initWithTextKitAttributes:{
+     .attributedString = [[NSAttributedString alloc] initWithString:post]
+   }
+   constrainedSize:{ 320, CGFLOAT_MAX }];
+  CKTextKitRenderer *labelRenderer =
+  [[CKTextKitRenderer alloc]
+   initWithTextKitAttributes:{
+     .attributedString = [[NSAttributedString alloc] initWithString:@"Yes"]
+   }
+   constrainedSize:{ 320, CGFLOAT_MAX }];
+
+  XCTAssertGreaterThan(postRenderer.estimatedByteCost, post.length * sizeof(unichar));
+  XCTAssertGreaterThan(postRenderer.estimatedByteCost, 10 * labelRenderer.estimatedByteCost);
+}
+
+- (void)testAttributesThatOnlyDifferInColorHaveTheSameLayoutAttributes
+{
+  UIFont *font = [UIFont systemFontOfSize:12];
+  CKTextKitAttributes red {
+    .attributedString = [[NSAttributedString alloc] initWithString:@"3 new messages"
+                                                        attributes:@{NSFontAttributeName: font, NSForegroundColorAttributeName: [UIColor redColor]}],
+  };
+  CKTextKitAttributes blue {
+    .attributedString = [[NSAttributedString alloc] initWithString:@"3 new messages"
+                                                        attributes:@{NSFontAttributeName: font, NSForegroundColorAttributeName: [UIColor blueColor]}],
+  };
+  CKTextKitAttributes bigger {
+    .attributedString = [[NSAttributedString alloc] initWithString:@"3 new messages"
+                                                        attributes:@{NSFontAttributeName: [UIFont systemFontOfSize:14], NSForegroundColorAttributeName: [UIColor redColor]}],
+  };
+
+  XCTAssertFalse(red == blue);
+  XCTAssertTrue(red.layoutAttributes() == blue.layoutAttributes());
+  XCTAssertFalse(red.layoutAttributes() == bigger.layoutAttributes());
+}
+
+- (void)testRepaintingRendererSharesTheLayoutAndDrawsItsOwnColors
+{
+  if (@available(iOS 13.0, tvOS 13.0, *)) {
+  } else {
+    return;
+  }
+  UIFont *font = [UIFont systemFontOfSize:20];
+  CKTextKitRenderer *red =
+  [[CKTextKitRenderer alloc]
+   initWithTextKitAttributes:{
+     .attributedString = [[NSAttributedString alloc] initWithString:@"MMM"
+                                                         attributes:@{NSFontAttributeName: font, NSBackgroundColorAttributeName: [UIColor redColor]}],
+   }
+   constrainedSize:{ 200, 100 }];
+  CKTextKitRenderer *blue =
+  [[CKTextKitRenderer alloc]
+   initWithTextKitAttributes:{
+     .attributedString = [[NSAttributedString alloc] initWithString:@"MMM"
+                                                         attributes:@{NSFontAttributeName: font, NSBackgroundColorAttributeName: [UIColor blueColor]}],
+   }
+   repaintingRenderer:red];
+
+  XCTAssertNotNil(blue);
+  XCTAssertEqual(blue.context, red.context);
+  XCTAssertTrue(CGSizeEqualToSize(blue.size, red.size));
+  // Caches only weigh the shared layout once.
+  XCTAssertLessThan(blue.estimatedByteCost, red.estimatedByteCost / 2);
+
+  // The text's background fills its whole line: compare the color each renderer draws in its middle, drawing the
+  // original again afterwards to check the shared layout was left as it was.
+  UIColor *(^colorDrawnBy)(CKTextKitRenderer *) = ^(CKTextKitRenderer *renderer) {
+    uint8_t pixel[4] = {0, 0, 0, 0};
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(pixel, 1, 1, 8, 4, colorSpace, kCGImageAlphaPremultipliedLast);
+    CGColorSpaceRelease(colorSpace);
+    const CGPoint point = {renderer.size.width / 2, renderer.size.height / 2};
+    CGContextTranslateCTM(context, -point.x, point.y + 1);
+    CGContextScaleCTM(context, 1, -1);
+    [renderer drawInContext:context bounds:{CGPointZero, renderer.size}];
+    CGContextRelease(context);
+    return [UIColor colorWithRed:pixel[0] / 255.0 green:pixel[1] / 255.0 blue:pixel[2] / 255.0 alpha:pixel[3] / 255.0];
+  };
+  CGFloat r, g, b, a;
+  [colorDrawnBy(blue) getRed:&r green:&g blue:&b alpha:&a];
+  XCTAssertGreaterThan(b, r);
+  [colorDrawnBy(red) getRed:&r green:&g blue:&b alpha:&a];
+  XCTAssertGreaterThan(r, b);
+}
+
+- (void)testMeasurementsOfWrappedTextHoldAcrossTheirWholeRangeOfWidths
+{
+  // Hyphens, slashes, dashes and URLs all give TextKit places to break besides the spaces between words.
+  const CKTextKitAttributes attributes {
+    .attributedString =
+    [[NSAttributedString alloc] initWithString:@"Well-known long-standing foo-bar words, either/or choices, em\u2014dashes "
+     "and links like https://www.example.com/some/long/path?query=value wrap across several lines."
+                                    attributes:@{NSFontAttributeName: [UIFont systemFontOfSize:15]}],
+  };
+
+  NSUInteger rangesChecked = 0;
+  for (CGFloat constrainedWidth = 120; constrainedWidth <= 300; constrainedWidth += 15) {
+    const CK::TextKit::Measurement::Measured measured =
+    CK::TextKit::Measurement::measure(attributes, {constrainedWidth, CGFLOAT_MAX});
+    XCTAssertGreaterThan(measured.metrics.lineCount, 1u);
+    if (!(measured.maximumWidth > measured.minimumWidth)) {
+      continue;
+    }
+    rangesChecked++;
+    // Every width the measurement claims to be valid for lays the text out the same way.
+    const CGFloat maximumWidth = MIN(measured.maximumWidth, measured.minimumWidth + 100);
+    for (CGFloat width = measured.minimumWidth; width < maximumWidth; width += 0.5) {
+      XCTAssertTrue(measured.isValidForWidth(width));
+      const CK::TextKit::Measurement::Measured fresh = CK::TextKit::Measurement::measure(attributes, {width, CGFLOAT_MAX});
+      XCTAssertEqual(fresh.metrics.lineCount, measured.metrics.lineCount, @"at %f, measured at %f", width, constrainedWidth);
+      XCTAssertEqual(fresh.metrics.size.height, measured.metrics.size.height, @"at %f, measured at %f", width, constrainedWidth);
+    }
+  }
+  XCTAssertGreaterThan(rangesChecked, 0u);
+}
+
+- (void)testMeasuringParagraphsConcurrentlyMeasuresLikeASingleLayout
+{
+  NSMutableString *article = [NSMutableString string];
+  for (NSUInteger i = 0; i < 40; i++) {
+    [article appendString:[@"" stringByPaddingToLength:40 + 7 * i withString:@"Paragraphs are laid out on their own. " startingAtIndex:0]];
+    [article appendString:(i % 5 == 0) ? @"\n\n" : @"\n"];
+  }
+  NSMutableParagraphStyle *style = [NSMutableParagraphStyle new];
+  style.paragraphSpacing = 6;
+  style.lineSpacing = 2;
+  const CKTextKitAttributes attributes {
+    .attributedString = [[NSAttributedString alloc] initWithString:article
+                                                        attributes:@{NSFontAttributeName: [UIFont systemFontOfSize:15],
+                                                                     NSParagraphStyleAttributeName: style}],
+  };
+  const CGSize constrainedSize = {320, CGFLOAT_MAX};
+
+  CK::TextKit::Measurement::Measured paragraphs;
+  XCTAssertTrue(CK::TextKit::Measurement::measureParagraphs(attributes, constrainedSize, paragraphs));
+  const CK::TextKit::Measurement::Measured single = CK::TextKit::Measurement::measure(attributes, constrainedSize);
+
+  XCTAssertTrue(CGSizeEqualToSize(paragraphs.metrics.size, single.metrics.size));
+  XCTAssertEqual(paragraphs.metrics.baseline, single.metrics.baseline);
+  XCTAssertEqual(paragraphs.metrics.lineCount, single.metrics.lineCount);
+  XCTAssertEqual(paragraphs.minimumWidth, single.minimumWidth);
+  XCTAssertEqual(paragraphs.maximumWidth, single.maximumWidth);
+
+  // Text that would be truncated is left to a single layout.
+  CKTextKitAttributes limited = attributes;
+  limited.maximumNumberOfLines = 10;
+  XCTAssertFalse(CK::TextKit::Measurement::measureParagraphs(limited, constrainedSize, paragraphs));
+  XCTAssertFalse(CK::TextKit::Measurement::measureParagraphs(attributes, {320, 200}, paragraphs));
+}
+
 @end
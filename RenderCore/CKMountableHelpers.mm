@@ -10,12 +10,15 @@
 
 #import "CKMountableHelpers.h"
 
+#import <QuartzCore/QuartzCore.h>
+
 #import <RenderCore/RCAssert.h>
 #import <RenderCore/RCComponentDescriptionHelper.h>
 #import <RenderCore/CKMountable.h>
 #import <RenderCore/CKMountableHelpers.h>
 #import <RenderCore/CKMountedObjectForView.h>
 #import <RenderCore/CKViewConfiguration.h>
+#import <RenderCore/ComponentViewReuseUtilities.h>
 #import <RenderCore/RCFatal.h>
 
 static void relinquishMountedView(std::unique_ptr<CKMountInfo> &mountInfo,
@@ -68,7 +71,14 @@ CK::Component::MountResult CKPerformMount(std::unique_ptr<CKMountInfo> &mountInf
       relinquishMountedView(mountInfo, layout.component, willRelinquishViewFunction); // First release our old view
       [currentMountedComponent unmount]; // Then unmount old component (if any) from the new view
       CKSetMountedObjectForView(v, layout.component);
-      CK::Component::AttributeApplicator::apply(v, viewConfiguration);
+      const auto trace = context.mountAnalyticsContext ? context.mountAnalyticsContext->trace.get() : nullptr;
+      const auto start = trace ? CACurrentMediaTime() : 0;
+      CK::Component::AttributeApplicator::apply(v, viewConfiguration, context.mountPreparation.get());
+      if (trace) {
+        trace->record({layout.component.class, viewConfiguration.viewClass().getIdentifier(), viewConfiguration.attributeShape()},
+                      CK::Component::MountTrace::attributeApplication,
+                      CACurrentMediaTime() - start);
+      }
       acquiredView = v;
       mountInfo->view = v;
     } else {
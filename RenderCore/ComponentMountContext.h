@@ -24,9 +24,11 @@ namespace CK {
 
     struct MountContext {
       /** Constructs a new mount context for the given view. */
-      static MountContext RootContext(UIView *v, MountAnalyticsContext *mAnalyticsContext) noexcept {
+      static MountContext RootContext(UIView *v,
+                                      MountAnalyticsContext *mAnalyticsContext,
+                                      std::shared_ptr<const MountPreparation> mPreparation = nullptr) noexcept {
         ViewReuseUtilities::mountingInRootView(v);
-        return MountContext(std::make_shared<ViewManager>(v, mAnalyticsContext), {0,0}, {}, NO, mAnalyticsContext);
+        return MountContext(std::make_shared<ViewManager>(v, mAnalyticsContext), {0,0}, {}, NO, mAnalyticsContext, mPreparation);
       }
 
       /** The view manager for the context. Components should be mounted using this view manager. */
@@ -39,21 +41,23 @@ namespace CK {
       BOOL shouldBlockAnimations;
       /** Mount analytics information */
       MountAnalyticsContext *mountAnalyticsContext;
+      /** Attribute diffs prepared before mount, if any. Shared, as contexts may be kept to mount children later. */
+      std::shared_ptr<const MountPreparation> mountPreparation;
 
       MountContext offset(const CGPoint p, const CGSize parentSize, const CGSize childSize) const {
         const UIEdgeInsets guide = adjustedGuide(layoutGuide, p, parentSize, childSize);
-        return MountContext(viewManager, position + p, guide, shouldBlockAnimations, mountAnalyticsContext);
+        return MountContext(viewManager, position + p, guide, shouldBlockAnimations, mountAnalyticsContext, mountPreparation);
       };
 
       MountContext childContextForSubview(UIView *subview, const BOOL didBlockAnimations) const {
         ViewReuseUtilities::mountingInChildContext(subview, viewManager->view);
         const BOOL shouldBlockChildAnimations = shouldBlockAnimations || didBlockAnimations;
-        return MountContext(std::make_shared<ViewManager>(subview, mountAnalyticsContext), {0,0}, layoutGuide, shouldBlockChildAnimations, mountAnalyticsContext);
+        return MountContext(std::make_shared<ViewManager>(subview, mountAnalyticsContext), {0,0}, layoutGuide, shouldBlockChildAnimations, mountAnalyticsContext, mountPreparation);
       };
 
     private:
-      MountContext(const std::shared_ptr<ViewManager> &m, const CGPoint p, const UIEdgeInsets l, const BOOL b, MountAnalyticsContext *ma)
-      : viewManager(m), position(p), layoutGuide(l), shouldBlockAnimations(b), mountAnalyticsContext(ma) {}
+      MountContext(const std::shared_ptr<ViewManager> &m, const CGPoint p, const UIEdgeInsets l, const BOOL b, MountAnalyticsContext *ma, const std::shared_ptr<const MountPreparation> &mp)
+      : viewManager(m), position(p), layoutGuide(l), shouldBlockAnimations(b), mountAnalyticsContext(ma), mountPreparation(mp) {}
 
       static UIEdgeInsets adjustedGuide(const UIEdgeInsets layoutGuide, const CGPoint offset,
                                         const CGSize parentSize, const CGSize childSize) noexcept {
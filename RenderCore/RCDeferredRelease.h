@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <RenderCore/CKDefines.h>
+
+#if CK_NOT_SWIFT
+
+#import <Foundation/Foundation.h>
+
+/**
+ Releases what mounting and unmounting drop in batches, rather than one by one wherever the last reference happens to go
+ away on the main thread.
+
+ Everything handed over on the main thread is kept until the outermost RCDeferredReleaseTransaction ends or, outside of
+ a transaction, until the main run loop is about to wait. It is then released at once: on a low priority background
+ queue, except for objects that must die on the main thread (views, layers and view controllers, or anything handed to
+ RCDeferReleaseOnMainThread), which are released together on the main thread.
+ */
+
+/** Takes over a reference to the object. Main thread only. */
+void RCDeferRelease(id object);
+
+/** Takes over a reference to an object that must be released on the main thread. Main thread only. */
+void RCDeferReleaseOnMainThread(id object);
+
+/** Hands over memory to be freed by the deleter on a background queue. Main thread only. */
+void RCDeferDelete(void *target, void (*deleter)(void *));
+
+/** Holds back releases until the outermost transaction ends. Main thread only. */
+class RCDeferredReleaseTransaction {
+public:
+  RCDeferredReleaseTransaction() noexcept;
+  ~RCDeferredReleaseTransaction();
+
+  RCDeferredReleaseTransaction(const RCDeferredReleaseTransaction &) = delete;
+  RCDeferredReleaseTransaction &operator=(const RCDeferredReleaseTransaction &) = delete;
+};
+
+struct RCDeferredReleaseStatistics {
+  NSUInteger batches;
+  /** Objects and deletions handed over so far. */
+  NSUInteger releases;
+  /** Time spent releasing batches on the main thread, for objects that must die there. */
+  CFTimeInterval mainThreadDuration;
+  /** Time spent releasing batches in the background: main thread time saved when large trees are torn down. */
+  CFTimeInterval backgroundDuration;
+};
+
+RCDeferredReleaseStatistics RCGetDeferredReleaseStatistics();
+
+#endif
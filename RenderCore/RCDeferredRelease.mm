@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import "RCDeferredRelease.h"
+
+#import <climits>
+#import <vector>
+
+#import <QuartzCore/QuartzCore.h>
+#import <UIKit/UIKit.h>
+
+#import <RenderCore/CKMutex.h>
+#import <RenderCore/RCAssert.h>
+
+namespace {
+  struct Deletion {
+    void *target;
+    void (*deleter)(void *);
+  };
+
+  struct Batch {
+    std::vector<id> objects;
+    std::vector<Deletion> deletions;
+  };
+
+  struct PendingReleases {
+    Batch background;
+    std::vector<id> mainThreadObjects;
+    NSUInteger transactionDepth = 0;
+    CFRunLoopObserverRef flushObserver = nullptr;
+  };
+}
+
+static PendingReleases &pendingReleases()
+{
+  // Leaked on purpose, like other main thread singletons, to avoid running its destructor at exit.
+  static PendingReleases *pending = new PendingReleases();
+  return *pending;
+}
+
+static CK::StaticMutex statisticsMutex = CK_MUTEX_INITIALIZER; // protects statistics
+static RCDeferredReleaseStatistics statistics;
+
+static void releaseBatch(void *context)
+{
+  const auto start = CACurrentMediaTime();
+  const auto batch = (Batch *)context;
+  for (const auto &deletion : batch->deletions) {
+    deletion.deleter(deletion.target);
+  }
+  delete batch;
+  const auto duration = CACurrentMediaTime() - start;
+
+  CK::StaticMutexLocker l(statisticsMutex);
+  statistics.backgroundDuration += duration;
+}
+
+static void flush()
+{
+  auto &pending = pendingReleases();
+  if (!pending.background.objects.empty() || !pending.background.deletions.empty()) {
+    const auto batch = new Batch();
+    std::swap(*batch, pending.background);
+    dispatch_async_f(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), batch, &releaseBatch);
+    CK::StaticMutexLocker l(statisticsMutex);
+    statistics.batches++;
+  }
+  if (!pending.mainThreadObjects.empty()) {
+    const auto start = CACurrentMediaTime();
+    {
+      std::vector<id> objects;
+      std::swap(objects, pending.mainThreadObjects);
+    }
+    const auto duration = CACurrentMediaTime() - start;
+    CK::StaticMutexLocker l(statisticsMutex);
+    statistics.mainThreadDuration += duration;
+  }
+}
+
+static PendingReleases &pendingReleasesForEnqueueing()
+{
+  RCCAssertMainThread();
+  auto &pending = pendingReleases();
+  if (pending.flushObserver == nullptr) {
+    // Runs after Core Animation has committed the frame, so releasing never delays it.
+    pending.flushObserver =
+    CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault,
+                                       kCFRunLoopBeforeWaiting | kCFRunLoopExit,
+                                       true,
+                                       INT_MAX,
+                                       ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+                                         if (pendingReleases().transactionDepth == 0) {
+                                           flush();
+                                         }
+                                       });
+    CFRunLoopAddObserver(CFRunLoopGetMain(), pending.flushObserver, kCFRunLoopCommonModes);
+  }
+  CK::StaticMutexLocker l(statisticsMutex);
+  statistics.releases++;
+  return pending;
+}
+
+static BOOL mustBeReleasedOnMainThread(id object)
+{
+  return [object isKindOfClass:[UIView class]]
+  || [object isKindOfClass:[CALayer class]]
+  || [object isKindOfClass:[UIViewController class]];
+}
+
+void RCDeferRelease(id object)
+{
+  if (object == nil) {
+    return;
+  }
+  auto &pending = pendingReleasesForEnqueueing();
+  if (mustBeReleasedOnMainThread(object)) {
+    pending.mainThreadObjects.push_back(object);
+  } else {
+    pending.background.objects.push_back(object);
+  }
+}
+
+void RCDeferReleaseOnMainThread(id object)
+{
+  if (object == nil) {
+    return;
+  }
+  pendingReleasesForEnqueueing().mainThreadObjects.push_back(object);
+}
+
+void RCDeferDelete(void *target, void (*deleter)(void *))
+{
+  pendingReleasesForEnqueueing().background.deletions.push_back({target, deleter});
+}
+
+RCDeferredReleaseTransaction::RCDeferredReleaseTransaction() noexcept
+{
+  RCCAssertMainThread();
+  pendingReleases().transactionDepth++;
+}
+
+RCDeferredReleaseTransaction::~RCDeferredReleaseTransaction()
+{
+  auto &pending = pendingReleases();
+  if (--pending.transactionDepth == 0) {
+    flush();
+  }
+}
+
+RCDeferredReleaseStatistics RCGetDeferredReleaseStatistics()
+{
+  CK::StaticMutexLocker l(statisticsMutex);
+  return statistics;
+}
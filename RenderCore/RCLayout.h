@@ -12,6 +12,7 @@
 
 #if CK_NOT_SWIFT
 
+#import <array>
 #import <utility>
 #import <vector>
 
@@ -55,6 +56,51 @@ struct RCLayoutChild {
   RCLayout layout;
 };
 
+/**
+ A layout flattened into the order in which CKMountLayout mounts it, so that mounting is a flat loop rather than a
+ tree walk. Building a plan visits every node of the layout; do it off the main thread where possible.
+ */
+class RCMountPlan {
+public:
+  static constexpr uint32_t kNoParent = UINT32_MAX;
+
+  struct Item {
+    /** Points into the layout retained by the plan; the component is never nil. */
+    const RCLayout *layout;
+    /** Index of the item for the parent layout, or kNoParent for the root. */
+    uint32_t parent;
+    /** One past the index of the last item in this item's subtree; the subtree is skipped if children aren't mounted. */
+    uint32_t subtreeEnd;
+    /** Position of the layout within its parent. */
+    CGPoint position;
+    /**
+     Bounds of the layout and all of its descendants, in the root layout's coordinate space. Since children may overflow
+     their parents, this is what decides whether a subtree can be skipped when only part of the layout is mounted.
+     */
+    CGRect subtreeFrame;
+  };
+
+  explicit RCMountPlan(const RCLayout &layout,
+                       std::shared_ptr<const CK::Component::MountPreparation> preparation = nullptr) noexcept;
+  // Items point into _layout, so plans are shared rather than copied.
+  RCMountPlan(const RCMountPlan &) = delete;
+  RCMountPlan &operator=(const RCMountPlan &) = delete;
+
+  const RCLayout &layout() const noexcept { return _layout; }
+  /** Items in depth-first pre-order; a parent always precedes its children. */
+  const std::vector<Item> &items() const noexcept { return _items; }
+  /** Identities of the components of all items, sorted and without duplicates. */
+  const std::vector<uintptr_t> &sortedComponents() const noexcept { return _sortedComponents; }
+  /** Attribute diffs against the previously mounted generation, if they were prepared along with the plan. */
+  const auto &preparation() const noexcept { return _preparation; }
+
+private:
+  const RCLayout _layout;
+  std::vector<Item> _items;
+  std::vector<uintptr_t> _sortedComponents;
+  std::shared_ptr<const CK::Component::MountPreparation> _preparation;
+};
+
 @protocol CKMountLayoutListener <NSObject>
 
 /**
@@ -83,6 +129,96 @@ NSSet<id<CKMountable>> *CKMountLayout(const RCLayout &layout,
                                       CK::Component::MountAnalyticsContext *mountAnalyticsContext,
                                       id<CKMountLayoutListener> listener);
 
+/**
+ Mounts a precomputed plan; behaves like the variant above on the plan's layout.
+ @param mountRect Only subtrees whose frame overlaps the vertical extent of this rect, in the root layout's coordinate
+        space, are mounted; previously mounted components above or below it are unmounted. Content to either side of the
+        rect is always mounted. Pass CGRectInfinite to mount the whole layout.
+ */
+NSSet<id<CKMountable>> *CKMountLayout(const RCMountPlan &plan,
+                                      UIView *view,
+                                      NSSet<id<CKMountable>> *previouslyMountedComponents,
+                                      id<CKMountable> supercomponent,
+                                      CK::Component::MountAnalyticsContext *mountAnalyticsContext,
+                                      id<CKMountLayoutListener> listener,
+                                      CGRect mountRect = CGRectInfinite);
+
+/** Counts how long each slice of a time-sliced mount took, to tune the budget given to RCMountCursor. */
+struct RCMountTimeHistogram {
+  /** Upper bounds of the buckets in milliseconds; slices slower than the last bound are counted in an extra bucket. */
+  static constexpr std::array<double, 6> kBucketLimits = {{1, 2, 4, 8, 16, 33}};
+  std::array<NSUInteger, kBucketLimits.size() + 1> counts {};
+
+  void record(CFTimeInterval duration) noexcept;
+};
+
+/**
+ Mounts a plan over several main thread turns so that mounting a large layout doesn't drop frames. Items whose subtree
+ overlaps the visible rect are mounted first, then the rest of the layout top-down. Subtrees outside the mount rect are
+ skipped, as by CKMountLayout, and the listener is told about each component as CKMountLayout does.
+
+ Until the cursor reaches an item, whatever was previously mounted in its place keeps its frame and serves as a
+ placeholder: stale components are unmounted, and unused views hidden, only once the whole plan is mounted. Nothing else
+ may be mounted in the view while the cursor is unfinished; to mount something else instead, discard the cursor and pass
+ its mountedComponents() as the previously mounted components.
+ */
+class RCMountCursor {
+public:
+  RCMountCursor(std::shared_ptr<const RCMountPlan> plan,
+                UIView *view,
+                NSSet<id<CKMountable>> *previouslyMountedComponents,
+                id<CKMountable> supercomponent,
+                CGRect visibleRect,
+                CK::Component::MountAnalyticsContext *mountAnalyticsContext = nullptr,
+                id<CKMountLayoutListener> listener = nil,
+                CGRect mountRect = CGRectInfinite) noexcept;
+
+  /**
+   Mounts items until the budget is spent, and at least one item so that mounting always progresses. Objects released
+   while mounting are released in one batch at the end of the slice, as with RCDeferredReleaseTransaction.
+   @param histogram If non-null, records the time spent in this slice.
+   @return Whether the whole plan is now mounted.
+   */
+  bool mountWithBudget(CFTimeInterval budget, RCMountTimeHistogram *histogram = nullptr);
+
+  bool isFinished() const noexcept { return _finished; }
+
+  /**
+   Once finished, the components in the plan that were mounted. Before that, those mounted so far along with the
+   previously mounted components, which may all still be mounted.
+   */
+  NSSet<id<CKMountable>> *mountedComponents() const;
+
+private:
+  void finish();
+
+  std::shared_ptr<const RCMountPlan> _plan;
+  NSSet<id<CKMountable>> *_previouslyMountedComponents;
+  id<CKMountable> _supercomponent;
+  CK::Component::MountAnalyticsContext *_mountAnalyticsContext;
+  id<CKMountLayoutListener> _listener;
+  /** Indices of the items in mount order; a parent always comes before its children. */
+  std::vector<uint32_t> _order;
+  size_t _next = 0;
+  /** Whether each item was mounted, and for items whose children are to be mounted, the index of their context. */
+  std::vector<bool> _mountedItems;
+  std::vector<uint32_t> _contextIndices;
+  /** The root context first, then the contexts for children; kept alive so views aren't hidden until finished. */
+  std::vector<CK::Component::MountContext> _contexts;
+  std::vector<id<CKMountable>> _mountedComponents;
+  bool _finished = false;
+};
+
+/**
+ Mounts a slice of the cursor's plan immediately and another on each following main run loop turn until it is finished,
+ then calls the completion with the mounted components. Releasing all other references to the cursor stops mounting.
+ @param histogram If non-null, records the time spent in every slice; it must outlive the cursor.
+ */
+void CKMountLayoutInSlices(const std::shared_ptr<RCMountCursor> &cursor,
+                           CFTimeInterval budgetPerSlice,
+                           RCMountTimeHistogram *histogram,
+                           void (^completion)(NSSet<id<CKMountable>> *mountedComponents));
+
 /** Unmounts all components returned by a previous call to CKMountComponentLayout. */
 void CKUnmountComponents(NSSet<id<CKMountable>> *componentsToUnmount);
 
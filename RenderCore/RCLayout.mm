@@ -10,10 +10,16 @@
 
 #import "RCLayout.h"
 
-#import <stack>
+#import <QuartzCore/QuartzCore.h>
+
+#import <algorithm>
 #import <sstream>
 #import <unordered_map>
 
+#import <RenderCore/ComponentViewManager.h>
+#import <RenderCore/ComponentViewReuseUtilities.h>
+#import <RenderCore/RCDeferredRelease.h>
+
 /** Deletes the target off the main thread; important since component layouts are large recursive structures. */
 struct CKOffMainThreadDeleter {
   void operator()(std::vector<RCLayoutChild> *target) noexcept;
@@ -66,13 +72,13 @@ static void _deleteComponentLayoutChild(void *target) noexcept
 void CKOffMainThreadDeleter::operator()(std::vector<RCLayoutChild> *target) noexcept
 {
   // When deallocating a large layout tree this is called first on the root node
-  // so we dispatch once and deallocate the whole tree on a background thread.
+  // so we hand the whole tree over once, to be deallocated on a background thread
+  // along with everything else released in the same mount or frame.
   // However, if you have a RCLayout as an ivar/variable, it will be initialized
   // with the default contstructor and an empty vector. When you set the ivar, this method is called
-  // to deallocate the empty layout, and in this case it's not worth doing the dispatch.
+  // to deallocate the empty layout, and in this case it's not worth deferring.
   if ([NSThread isMainThread] && target && !target->empty()) {
-    // use dispatch_async_f to avoid block allocations
-    dispatch_async_f(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), target, &_deleteComponentLayoutChild);
+    RCDeferDelete(target, &_deleteComponentLayoutChild);
   } else {
     delete target;
   }
@@ -84,6 +90,47 @@ std::shared_ptr<const std::vector<RCLayoutChild>> RCLayout::emptyChildren() noex
   return cached;
 }
 
+RCMountPlan::RCMountPlan(const RCLayout &layout,
+                         std::shared_ptr<const CK::Component::MountPreparation> preparation) noexcept
+: _layout(layout), _preparation(std::move(preparation))
+{
+  // Each entry is the index of an item whose children are still to be appended, and the next child to append.
+  std::vector<std::pair<uint32_t, size_t>> stack;
+  // Origins of the items in the root layout's coordinate space; subtree frames grow as descendants are appended.
+  std::vector<CGPoint> origins;
+  const auto append = [&](const RCLayout &l, uint32_t parent, CGPoint position) {
+    if (l.component == nil) {
+      return; // Nil components in a layout struct are invalid, but handle them gracefully
+    }
+    const auto origin = parent == kNoParent ? position : origins[parent] + position;
+    origins.push_back(origin);
+    _items.push_back({&l, parent, 0, position, {origin, l.size}});
+    _sortedComponents.push_back((uintptr_t)(__bridge void *)l.component);
+    stack.push_back({(uint32_t)(_items.size() - 1), 0});
+  };
+
+  append(_layout, kNoParent, CGPointZero);
+  while (!stack.empty()) {
+    auto &top = stack.back();
+    const auto &children = *_items[top.first].layout->children;
+    if (top.second < children.size()) {
+      const auto &child = children[top.second++];
+      append(child.layout, top.first, child.position);
+    } else {
+      auto &item = _items[top.first];
+      item.subtreeEnd = (uint32_t)_items.size();
+      if (item.parent != kNoParent) {
+        auto &parentFrame = _items[item.parent].subtreeFrame;
+        parentFrame = CGRectUnion(parentFrame, item.subtreeFrame);
+      }
+      stack.pop_back();
+    }
+  }
+
+  std::sort(_sortedComponents.begin(), _sortedComponents.end());
+  _sortedComponents.erase(std::unique(_sortedComponents.begin(), _sortedComponents.end()), _sortedComponents.end());
+}
+
 NSSet<id<CKMountable>> *CKMountLayout(const RCLayout &layout,
                                       UIView *view,
                                       NSSet<id<CKMountable>> *previouslyMountedComponents,
@@ -91,60 +138,300 @@ NSSet<id<CKMountable>> *CKMountLayout(const RCLayout &layout,
                                       CK::Component::MountAnalyticsContext *mountAnalyticsContext,
                                       id<CKMountLayoutListener> listener)
 {
-  struct MountItem {
-    const RCLayout &layout;
-    MountContext mountContext;
-    id<CKMountable> supercomponent;
-    BOOL visited;
-  };
+  return CKMountLayout(RCMountPlan(layout), view, previouslyMountedComponents, supercomponent, mountAnalyticsContext, listener);
+}
+
+/** Unmounts the previously mounted components whose identities aren't in sortedMounted, walking both in identity order. */
+static void unmountComponentsNotIn(NSSet<id<CKMountable>> *previouslyMountedComponents,
+                                   const std::vector<uintptr_t> &sortedMounted)
+{
+  std::vector<id<CKMountable>> previousComponents;
+  previousComponents.reserve(previouslyMountedComponents.count);
+  for (id<CKMountable> component in previouslyMountedComponents) {
+    previousComponents.push_back(component);
+  }
+  std::sort(previousComponents.begin(), previousComponents.end(), [](id<CKMountable> lhs, id<CKMountable> rhs){
+    return (uintptr_t)(__bridge void *)lhs < (uintptr_t)(__bridge void *)rhs;
+  });
+  auto mounted = sortedMounted.begin();
+  for (const auto component : previousComponents) {
+    const auto identity = (uintptr_t)(__bridge void *)component;
+    while (mounted != sortedMounted.end() && *mounted < identity) {
+      ++mounted;
+    }
+    if (mounted == sortedMounted.end() || *mounted != identity) {
+      [component unmount];
+      // The previous mount's set is often the last owner; batch the release with the rest of what this mount drops.
+      RCDeferRelease(component);
+    }
+  }
+}
 
-  // Using a stack to mount ensures that the components are mounted
-  // in a DFS fashion which is handy if you want to animate a subpart
-  // of the tree
-  std::stack<MountItem> stack;
-  stack.push({layout, MountContext::RootContext(view, mountAnalyticsContext), supercomponent, NO});
-  auto const mountedComponents = CK::makeNonNull([NSMutableSet set]);
+static std::vector<uintptr_t> sortedIdentities(const std::vector<id<CKMountable>> &components)
+{
+  std::vector<uintptr_t> identities;
+  identities.reserve(components.size());
+  for (const auto c : components) {
+    identities.push_back((uintptr_t)(__bridge void *)c);
+  }
+  std::sort(identities.begin(), identities.end());
+  return identities;
+}
 
-  while (!stack.empty()) {
-    MountItem &item = stack.top();
-    if (item.visited) {
-      if (auto const c = item.layout.component) {
+/**
+ Whether the frame spans some of the rect's vertical extent, zero-sized frames on its edge included. Mounting is only
+ culled along the vertical scroll axis: content to the sides of the rect, such as the pages of a nested horizontal scroll
+ view, is scrolled into view without the rect moving, so it is always mounted.
+ */
+static bool frameOverlapsRectVertically(const CGRect &frame, const CGRect &rect) noexcept
+{
+  return CGRectGetMinY(frame) <= CGRectGetMaxY(rect) && CGRectGetMaxY(frame) >= CGRectGetMinY(rect);
+}
+
+NSSet<id<CKMountable>> *CKMountLayout(const RCMountPlan &plan,
+                                      UIView *view,
+                                      NSSet<id<CKMountable>> *previouslyMountedComponents,
+                                      id<CKMountable> supercomponent,
+                                      CK::Component::MountAnalyticsContext *mountAnalyticsContext,
+                                      id<CKMountLayoutListener> listener,
+                                      CGRect mountRect)
+{
+  const RCDeferredReleaseTransaction deferredReleaseTransaction;
+  const auto &items = plan.items();
+  std::vector<id<CKMountable>> mountedComponents;
+  mountedComponents.reserve(items.size());
+  bool skippedItems = false;
+
+  {
+    struct MountedItem {
+      uint32_t index;
+      MountContext contextForChildren;
+    };
+
+    const auto rootContext = MountContext::RootContext(view, mountAnalyticsContext, plan.preparation());
+    const auto trace = mountAnalyticsContext ? mountAnalyticsContext->trace.get() : nullptr;
+    // Items whose subtree is still being mounted, innermost last. The plan is in depth-first order, so the components
+    // are mounted in a DFS fashion which is handy if you want to animate a subpart of the tree.
+    std::vector<MountedItem> mountedItems;
+    const auto didMountItemsEndingAt = [&](uint32_t index) {
+      while (!mountedItems.empty() && items[mountedItems.back().index].subtreeEnd <= index) {
+        auto const c = items[mountedItems.back().index].layout->component;
+        // Release the children's context first so that its view manager is done with their views before notifying.
+        mountedItems.pop_back();
+        const auto start = trace ? CACurrentMediaTime() : 0;
         [c childrenDidMount];
+        if (trace) {
+          trace->record([c class], MountTrace::didMount, CACurrentMediaTime() - start);
+        }
         [listener didMountComponent:c];
       }
-      stack.pop();
-    } else {
-      item.visited = YES;
-      if (item.layout.component == nil) {
-        continue; // Nil components in a layout struct are invalid, but handle them gracefully
+    };
+
+    for (uint32_t i = 0; i < items.size();) {
+      didMountItemsEndingAt(i);
+
+      const auto &item = items[i];
+      if (!frameOverlapsRectVertically(item.subtreeFrame, mountRect)) {
+        skippedItems = true;
+        i = item.subtreeEnd;
+        continue;
       }
-      [listener willMountComponent:item.layout.component];
-      const MountResult mountResult = [item.layout.component mountInContext:item.mountContext
-                                                                     layout:item.layout
-                                                             supercomponent:item.supercomponent];
-      [mountedComponents addObject:item.layout.component];
+      auto const component = item.layout->component;
+      [listener willMountComponent:component];
+      const MountResult mountResult =
+      item.parent == RCMountPlan::kNoParent
+      ? [component mountInContext:rootContext layout:*item.layout supercomponent:supercomponent]
+      : [component mountInContext:mountedItems.back().contextForChildren.offset(item.position,
+                                                                                items[item.parent].layout->size,
+                                                                                item.layout->size)
+                           layout:*item.layout
+                   supercomponent:items[item.parent].layout->component];
+      mountedComponents.push_back(component);
+      mountedItems.push_back({i, mountResult.contextForChildren});
 
       if (mountResult.mountChildren) {
-        // Ordering of components should correspond to ordering of mount. Push components on backwards so the
-        // bottom-most component is mounted first.
-        for (auto riter = item.layout.children->rbegin(); riter != item.layout.children->rend(); riter ++) {
-          stack.push({riter->layout, mountResult.contextForChildren.offset(riter->position, item.layout.size, riter->layout.size), item.layout.component, NO});
-        }
+        i++;
+      } else {
+        skippedItems = true;
+        i = item.subtreeEnd;
       }
     }
+    didMountItemsEndingAt((uint32_t)items.size());
   }
 
-  // Unmount any components that were in previouslyMountedComponents but are no longer in mountedComponents.
-  for (id<CKMountable> component in previouslyMountedComponents) {
-    if (![mountedComponents containsObject:component]) {
-      [component unmount];
+  // Unmount any components that were previously mounted but are no longer.
+  if (skippedItems) {
+    unmountComponentsNotIn(previouslyMountedComponents, sortedIdentities(mountedComponents));
+  } else {
+    unmountComponentsNotIn(previouslyMountedComponents, plan.sortedComponents());
+  }
+
+  return [NSSet setWithObjects:mountedComponents.data() count:mountedComponents.size()];
+}
+
+constexpr std::array<double, 6> RCMountTimeHistogram::kBucketLimits;
+
+void RCMountTimeHistogram::record(CFTimeInterval duration) noexcept
+{
+  const auto milliseconds = duration * 1000;
+  const auto bucket = std::lower_bound(kBucketLimits.begin(), kBucketLimits.end(), milliseconds) - kBucketLimits.begin();
+  counts[bucket]++;
+}
+
+static constexpr uint32_t kNoContext = UINT32_MAX;
+
+RCMountCursor::RCMountCursor(std::shared_ptr<const RCMountPlan> plan,
+                             UIView *view,
+                             NSSet<id<CKMountable>> *previouslyMountedComponents,
+                             id<CKMountable> supercomponent,
+                             CGRect visibleRect,
+                             MountAnalyticsContext *mountAnalyticsContext,
+                             id<CKMountLayoutListener> listener,
+                             CGRect mountRect) noexcept
+: _plan(std::move(plan)),
+  _previouslyMountedComponents(previouslyMountedComponents),
+  _supercomponent(supercomponent),
+  _mountAnalyticsContext(mountAnalyticsContext),
+  _listener(listener)
+{
+  const auto &items = _plan->items();
+  _order.reserve(items.size());
+  // Visible subtrees first, then everything else within the mount rect; both in depth-first order, so parents precede
+  // their children.
+  enum : uint8_t { kSkipped, kVisible, kOther };
+  std::vector<uint8_t> kinds(items.size(), kSkipped);
+  for (uint32_t i = 0; i < items.size();) {
+    if (frameOverlapsRectVertically(items[i].subtreeFrame, mountRect)) {
+      kinds[i] = frameOverlapsRectVertically(items[i].subtreeFrame, visibleRect) ? kVisible : kOther;
+      i++;
+    } else {
+      i = items[i].subtreeEnd;
+    }
+  }
+  for (uint32_t i = 0; i < items.size(); i++) {
+    if (kinds[i] == kVisible) {
+      _order.push_back(i);
+    }
+  }
+  for (uint32_t i = 0; i < items.size(); i++) {
+    if (kinds[i] == kOther) {
+      _order.push_back(i);
+    }
+  }
+  _mountedItems.resize(items.size());
+  _contextIndices.resize(items.size(), kNoContext);
+  _mountedComponents.reserve(items.size());
+  _contexts.push_back(MountContext::RootContext(view, mountAnalyticsContext, _plan->preparation()));
+}
+
+bool RCMountCursor::mountWithBudget(CFTimeInterval budget, RCMountTimeHistogram *histogram)
+{
+  RCCAssertMainThread();
+  if (_finished) {
+    return true;
+  }
+  const RCDeferredReleaseTransaction deferredReleaseTransaction;
+  const auto &items = _plan->items();
+  const auto start = CACurrentMediaTime();
+  while (_next < _order.size()) {
+    const auto i = _order[_next++];
+    const auto &item = items[i];
+    if (item.parent != RCMountPlan::kNoParent && _contextIndices[item.parent] == kNoContext) {
+      // The parent didn't mount its children, so its descendants are never mounted.
+      continue;
+    }
+    auto const component = item.layout->component;
+    [_listener willMountComponent:component];
+    const MountResult mountResult =
+    item.parent == RCMountPlan::kNoParent
+    ? [component mountInContext:_contexts.front() layout:*item.layout supercomponent:_supercomponent]
+    : [component mountInContext:_contexts[_contextIndices[item.parent]].offset(item.position,
+                                                                              items[item.parent].layout->size,
+                                                                              item.layout->size)
+                         layout:*item.layout
+                 supercomponent:items[item.parent].layout->component];
+    _mountedItems[i] = true;
+    _mountedComponents.push_back(component);
+    if (mountResult.mountChildren) {
+      _contextIndices[i] = (uint32_t)_contexts.size();
+      _contexts.push_back(mountResult.contextForChildren);
+    }
+    if (CACurrentMediaTime() - start >= budget) {
+      break;
+    }
+  }
+
+  if (_next == _order.size()) {
+    finish();
+  }
+  if (histogram != nullptr) {
+    histogram->record(CACurrentMediaTime() - start);
+  }
+  return _finished;
+}
+
+void RCMountCursor::finish()
+{
+  const RCDeferredReleaseTransaction deferredReleaseTransaction;
+  _finished = true;
+  // Releasing the contexts lets their view managers hide the views that no longer have a component.
+  _contexts.clear();
+  _contexts.shrink_to_fit();
+  // Children before their parents, as when mounting in one go.
+  const auto &items = _plan->items();
+  const auto trace = _mountAnalyticsContext ? _mountAnalyticsContext->trace.get() : nullptr;
+  for (auto i = items.size(); i > 0; i--) {
+    if (_mountedItems[i - 1]) {
+      auto const c = items[i - 1].layout->component;
+      const auto start = trace ? CACurrentMediaTime() : 0;
+      [c childrenDidMount];
+      if (trace) {
+        trace->record([c class], MountTrace::didMount, CACurrentMediaTime() - start);
+      }
+      [_listener didMountComponent:c];
     }
   }
-  return mountedComponents;
+  unmountComponentsNotIn(_previouslyMountedComponents, sortedIdentities(_mountedComponents));
+  _previouslyMountedComponents = nil;
+}
+
+NSSet<id<CKMountable>> *RCMountCursor::mountedComponents() const
+{
+  NSSet<id<CKMountable>> *const mounted = [NSSet setWithObjects:_mountedComponents.data() count:_mountedComponents.size()];
+  return _finished ? mounted : [mounted setByAddingObjectsFromSet:_previouslyMountedComponents ?: [NSSet set]];
+}
+
+static void mountNextSlice(std::weak_ptr<RCMountCursor> weakCursor,
+                           CFTimeInterval budgetPerSlice,
+                           RCMountTimeHistogram *histogram,
+                           void (^completion)(NSSet<id<CKMountable>> *mountedComponents))
+{
+  const auto cursor = weakCursor.lock();
+  if (cursor == nullptr) {
+    return;
+  }
+  if (cursor->mountWithBudget(budgetPerSlice, histogram)) {
+    if (completion) {
+      completion(cursor->mountedComponents());
+    }
+    return;
+  }
+  dispatch_async(dispatch_get_main_queue(), ^{
+    mountNextSlice(weakCursor, budgetPerSlice, histogram, completion);
+  });
+}
+
+void CKMountLayoutInSlices(const std::shared_ptr<RCMountCursor> &cursor,
+                           CFTimeInterval budgetPerSlice,
+                           RCMountTimeHistogram *histogram,
+                           void (^completion)(NSSet<id<CKMountable>> *mountedComponents))
+{
+  mountNextSlice(cursor, budgetPerSlice, histogram, completion);
 }
 
 void CKUnmountComponents(NSSet<id<CKMountable>> *componentsToUnmount)
 {
+  const RCDeferredReleaseTransaction deferredReleaseTransaction;
   for (id<CKMountable> component in componentsToUnmount) {
     [component unmount];
   }
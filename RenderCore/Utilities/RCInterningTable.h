@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2014-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#import <RenderCore/CKDefines.h>
+
+#if CK_NOT_SWIFT
+
+#import <atomic>
+#import <functional>
+#import <memory>
+#import <mutex>
+#import <vector>
+
+namespace CK {
+  /**
+   Interns keys into int32_t identifiers, handed out from 0 in the order keys are first seen.
+
+   Lookups never take a lock: the table is an open-addressed array of pointers to immutable entries, which are published
+   with release stores and read with acquire loads. Insertions are serialized by a mutex. Growing the table publishes a
+   new array; retired arrays are kept alive since readers may still be probing them, which costs less than the live
+   array thanks to geometric growth. Entries are never freed either, so tables are meant to be leaked singletons.
+
+   Keys can be looked up through another type, so that a hit doesn't have to build a key: `Hash` and `Equal` must then
+   accept it too, and hash it as they would the key it stands for.
+   */
+  template <typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<>>
+  class InterningTable {
+  public:
+    InterningTable(size_t initialCapacity) noexcept
+    {
+      // Capacities are powers of two, so probes can wrap with a mask.
+      size_t capacity = 1;
+      while (capacity < initialCapacity) {
+        capacity *= 2;
+      }
+      _tables.emplace_back(new Table(capacity));
+      _table.store(_tables.back().get(), std::memory_order_release);
+    }
+
+    int32_t intern(const Key &key) noexcept
+    {
+      return intern(key, [&]{ return key; });
+    }
+
+    /** Looks up `probe` without building a key; `makeKey` is only called when the key is seen for the first time. */
+    template <typename Probe, typename MakeKey>
+    int32_t intern(const Probe &probe, const MakeKey &makeKey) noexcept
+    {
+      const size_t hash = Hash()(probe);
+      if (const auto entry = find(_table.load(std::memory_order_acquire), hash, probe)) {
+        return entry->identifier;
+      }
+
+      std::lock_guard<std::mutex> l(_mutex);
+      auto table = _table.load(std::memory_order_relaxed);
+      // Another thread may have inserted the same key since our lookup.
+      if (const auto entry = find(table, hash, probe)) {
+        return entry->identifier;
+      }
+      const auto entry = new Entry {hash, makeKey(), (int32_t)_entries.size()};
+      // Keep the load factor under 1/2 so probe sequences stay short.
+      if ((_entries.size() + 1) * 2 > table->mask + 1) {
+        auto grownTable = new Table((table->mask + 1) * 2);
+        for (const auto e : _entries) {
+          store(grownTable, e);
+        }
+        _tables.emplace_back(grownTable);
+        _table.store(grownTable, std::memory_order_release);
+        table = grownTable;
+      }
+      _entries.push_back(entry);
+      store(table, entry);
+      return entry->identifier;
+    }
+
+  private:
+    struct Entry {
+      size_t hash;
+      Key key;
+      int32_t identifier;
+    };
+
+    struct Table {
+      Table(size_t capacity) : mask(capacity - 1), slots(new std::atomic<const Entry *>[capacity]) {
+        for (size_t i = 0; i < capacity; i++) {
+          slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+      }
+      const size_t mask;
+      const std::unique_ptr<std::atomic<const Entry *>[]> slots;
+    };
+
+    template <typename Probe>
+    static const Entry *find(const Table *table, size_t hash, const Probe &probe) noexcept
+    {
+      for (size_t i = hash & table->mask;; i = (i + 1) & table->mask) {
+        const auto entry = table->slots[i].load(std::memory_order_acquire);
+        if (entry == nullptr || (entry->hash == hash && Equal()(entry->key, probe))) {
+          return entry;
+        }
+      }
+    }
+
+    static void store(const Table *table, const Entry *entry) noexcept
+    {
+      size_t i = entry->hash & table->mask;
+      while (table->slots[i].load(std::memory_order_relaxed) != nullptr) {
+        i = (i + 1) & table->mask;
+      }
+      table->slots[i].store(entry, std::memory_order_release);
+    }
+
+    std::atomic<const Table *> _table;
+    /** Everything below is protected by `_mutex`. */
+    std::mutex _mutex;
+    std::vector<const Entry *> _entries;
+    std::vector<std::unique_ptr<const Table>> _tables;
+  };
+}
+
+#endif
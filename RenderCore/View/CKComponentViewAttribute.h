@@ -14,6 +14,7 @@
 
 #import <string>
 #import <unordered_map>
+#import <vector>
 
 #import <UIKit/UIKit.h>
 #import <RenderCore/RCEqualityHelpers.h>
@@ -74,11 +75,14 @@ struct CKComponentViewAttribute {
   static CKComponentViewAttribute LayerAttribute(SEL setter) noexcept;
 
   std::string identifier;
+  /** `identifier` interned to a small integer on construction; equal identifiers always intern to the same integer. */
+  int32_t internedIdentifier;
   void (^applicator)(id view, id value);
   void (^unapplicator)(id view, id value);
   void (^updater)(id view, id oldValue, id newValue);
 
-  bool operator==(const CKComponentViewAttribute &attr) const { return identifier == attr.identifier; };
+  bool operator==(const CKComponentViewAttribute &attr) const { return internedIdentifier == attr.internedIdentifier; };
+  bool operator<(const CKComponentViewAttribute &attr) const { return internedIdentifier < attr.internedIdentifier; };
 };
 
 struct CKBoxedValue {
@@ -119,7 +123,52 @@ private:
 
 };
 
-typedef std::unordered_map<CKComponentViewAttribute, CKBoxedValue> CKViewComponentAttributeValueMap;
+/**
+ Maps attributes to their values. It offers the subset of the std::unordered_map interface used for attributes, but is
+ backed by a vector sorted by interned identifier: attribute maps are small, so a binary search on integers is cheaper
+ than hashing identifier strings, and two maps can be diffed with a linear merge.
+ */
+class CKViewComponentAttributeValueMap {
+public:
+  using key_type = CKComponentViewAttribute;
+  using mapped_type = CKBoxedValue;
+  using value_type = std::pair<CKComponentViewAttribute, CKBoxedValue>;
+  using iterator = std::vector<value_type>::iterator;
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  CKViewComponentAttributeValueMap() noexcept {};
+  /** As with std::unordered_map, the first value given for an attribute wins. */
+  CKViewComponentAttributeValueMap(std::initializer_list<value_type> values);
+
+  /** Inserts the value unless the attribute is already present, in which case the map is left unchanged. */
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last)
+  {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  CKBoxedValue &operator[](const CKComponentViewAttribute &attribute);
+
+  iterator find(const CKComponentViewAttribute &attribute) noexcept;
+  const_iterator find(const CKComponentViewAttribute &attribute) const noexcept;
+  size_t count(const CKComponentViewAttribute &attribute) const noexcept { return find(attribute) != end() ? 1 : 0; }
+
+  iterator begin() noexcept { return _values.begin(); }
+  iterator end() noexcept { return _values.end(); }
+  const_iterator begin() const noexcept { return _values.begin(); }
+  const_iterator end() const noexcept { return _values.end(); }
+  size_t size() const noexcept { return _values.size(); }
+  bool empty() const noexcept { return _values.empty(); }
+  void reserve(size_t count) { _values.reserve(count); }
+
+private:
+  iterator lowerBound(int32_t internedIdentifier) noexcept;
+  std::vector<value_type> _values;
+};
 
 namespace std {
 
@@ -127,7 +176,7 @@ namespace std {
   {
     size_t operator()(const CKComponentViewAttribute &attr) const noexcept
     {
-      return hash<std::string>()(attr.identifier);
+      return hash<int32_t>()(attr.internedIdentifier);
     }
   };
 }
@@ -135,8 +184,8 @@ namespace std {
  This typedef is provided for convenience for helper functions that return both an attribute and a value, ready-made
  for dropping into the initialization list for attributes.
  e.g: It is currently used in CKComponentViewConfiguration, CKComponentViewConfiguration.attribute is of type
- std::unordered_map<CKComponentViewAttribute, id> (CKViewComponentAttributeValueMap). Its aggregate initialization
- constructor takes a list of std::pair<CKComponentViewAttribute, id>.
+ CKViewComponentAttributeValueMap. Its aggregate initialization constructor takes a list of
+ std::pair<CKComponentViewAttribute, id>.
  */
 typedef CKViewComponentAttributeValueMap::value_type CKComponentViewAttributeValue;
 
@@ -157,9 +206,6 @@ namespace std {
 
 }
 
-// Explicitly instantiate this CKViewComponentAttributeValueMap to improve compile time.
-extern template class std::unordered_map<CKComponentViewAttribute, CKBoxedValue>;
-
 namespace CK {
 namespace Component {
 /**
@@ -179,7 +225,8 @@ private:
   friend struct ::std::hash<PersistentAttributeShape>;
   /**
    This is a int32_t since they are compared on the main thread where we want optimal performance.
-   Behind the scenes, these are looked up/created using a map of unordered_set<string> -> int32_t.
+   Behind the scenes, these are interned from the set of interned attribute identifiers by a table that is read without
+   locking.
    */
   int32_t _identifier;
   static int32_t computeIdentifier(const CKViewComponentAttributeValueMap &attributes) noexcept;
@@ -11,12 +11,14 @@
 #import "CKComponentViewAttribute.h"
 
 #import <objc/runtime.h>
+#import <algorithm>
 #import <unordered_map>
 
 #import <RenderCore/RCAssert.h>
 #import <RenderCore/RCAssert.h>
 #import <RenderCore/RCEqualityHelpers.h>
 #import <RenderCore/CKMacros.h>
+#import <RenderCore/RCInterningTable.h>
 
 /**
  * Helper macro for asserting that an @encode type is the same size as
@@ -205,17 +207,26 @@ static void performSetter(id object, SEL setter, id value)
 #pragma clang diagnostic pop
 }
 
+static int32_t internedAttributeIdentifier(const std::string &identifier) noexcept
+{
+  // Attributes are created on any thread, so interning them mustn't contend on a lock.
+  static auto *interner = new CK::InterningTable<std::string>(512);
+  return interner->intern(identifier);
+}
+
 CKComponentViewAttribute::CKComponentViewAttribute(const std::string &ident,
                            void (^app)(id view, id value),
                            void (^unapp)(id view, id value),
                            void (^upd)(id view, id oldValue, id newValue)) :
   identifier(ident),
+  internedIdentifier(internedAttributeIdentifier(identifier)),
   applicator(app),
   unapplicator(unapp),
   updater(upd) {};
 
 CKComponentViewAttribute::CKComponentViewAttribute(SEL setter) noexcept :
 identifier(sel_getName(setter)),
+internedIdentifier(internedAttributeIdentifier(identifier)),
 applicator(^(UIView *view, id value){
   performSetter(view, setter, value);
 }) {}
@@ -230,4 +241,54 @@ CKComponentViewAttribute CKComponentViewAttribute::LayerAttribute(SEL setter) no
   });
 }
 
-template class std::unordered_map<CKComponentViewAttribute, CKBoxedValue>;
+CKViewComponentAttributeValueMap::CKViewComponentAttributeValueMap(std::initializer_list<value_type> values) : _values(values)
+{
+  // Stable so that, like std::unordered_map, the first of several values given for an attribute is kept.
+  std::stable_sort(_values.begin(), _values.end(), [](const value_type &lhs, const value_type &rhs){
+    return lhs.first < rhs.first;
+  });
+  _values.erase(std::unique(_values.begin(), _values.end(), [](const value_type &lhs, const value_type &rhs){
+    return lhs.first == rhs.first;
+  }), _values.end());
+}
+
+auto CKViewComponentAttributeValueMap::lowerBound(int32_t internedIdentifier) noexcept -> iterator
+{
+  return std::lower_bound(_values.begin(), _values.end(), internedIdentifier, [](const value_type &value, int32_t i){
+    return value.first.internedIdentifier < i;
+  });
+}
+
+auto CKViewComponentAttributeValueMap::insert(const value_type &value) -> std::pair<iterator, bool>
+{
+  const auto it = lowerBound(value.first.internedIdentifier);
+  if (it != _values.end() && it->first == value.first) {
+    return {it, false};
+  }
+  return {_values.insert(it, value), true};
+}
+
+auto CKViewComponentAttributeValueMap::insert(value_type &&value) -> std::pair<iterator, bool>
+{
+  const auto it = lowerBound(value.first.internedIdentifier);
+  if (it != _values.end() && it->first == value.first) {
+    return {it, false};
+  }
+  return {_values.insert(it, std::move(value)), true};
+}
+
+CKBoxedValue &CKViewComponentAttributeValueMap::operator[](const CKComponentViewAttribute &attribute)
+{
+  return insert({attribute, CKBoxedValue()}).first->second;
+}
+
+auto CKViewComponentAttributeValueMap::find(const CKComponentViewAttribute &attribute) noexcept -> iterator
+{
+  const auto it = lowerBound(attribute.internedIdentifier);
+  return it != _values.end() && it->first == attribute ? it : _values.end();
+}
+
+auto CKViewComponentAttributeValueMap::find(const CKComponentViewAttribute &attribute) const noexcept -> const_iterator
+{
+  return const_cast<CKViewComponentAttributeValueMap *>(this)->find(attribute);
+}
@@ -12,6 +12,7 @@
 
 #if CK_NOT_SWIFT
 
+#import <array>
 #import <deque>
 #import <string>
 #import <unordered_map>
@@ -74,8 +75,134 @@ namespace CK {
   }
 }
 
+namespace std {
+  template<> struct hash<CK::Component::ViewKey>
+  {
+    size_t operator()(const CK::Component::ViewKey &key) const noexcept
+    {
+      uint64_t hash = std::hash<uint64_t>()((uint64_t)(__bridge void *)key.componentClass);
+      hash = RCHashCombine(hash, std::hash<CKComponentViewClassIdentifier>()(key.viewClassIdentifier));
+      hash = RCHashCombine(hash, std::hash<CK::Component::PersistentAttributeShape>()(key.attributeShape));
+      return RCHash64ToNative(hash);
+    }
+  };
+}
+
 namespace CK {
   namespace Component {
+    /**
+     A breakdown of where mount time goes, by ViewKey and by component class. Collected into MountAnalyticsContext::trace
+     only when an analytics listener asks for it; otherwise mount code pays a null check per event. Export it with
+     JSONData() so that traces can be aggregated offline.
+     */
+    class MountTrace {
+    public:
+      enum Event : uint8_t {
+        /** Creating a view because none could be reused. */
+        viewCreation,
+        /** Applying attributes to a view a component acquired. */
+        attributeApplication,
+        /** Controller hooks before a component mounts, including willRemount. */
+        willMount,
+        /** Controller hooks once a component's children mounted, including didMount and didRemount. */
+        didMount,
+        eventCount,
+      };
+
+      struct Counter {
+        NSUInteger count = 0;
+        CFTimeInterval duration = 0;
+      };
+      using Counters = std::array<Counter, eventCount>;
+
+      /** Records the event for the key, and for its component class. */
+      void record(const ViewKey &key, Event event, CFTimeInterval duration) noexcept;
+      void record(Class componentClass, Event event, CFTimeInterval duration) noexcept;
+
+      /** nullptr if nothing was recorded for the key or class. */
+      const Counters *countersForViewKey(const ViewKey &key) const noexcept;
+      const Counters *countersForComponentClass(Class componentClass) const noexcept;
+
+      /**
+       A JSON object with "viewKeys" and "componentClasses" arrays. Each entry names its component class (and, for view
+       keys, view class and attribute shape) and maps every event that occurred to [count, total microseconds].
+       */
+      NSData *JSONData() const;
+
+    private:
+      struct ComponentClassCounters {
+        __unsafe_unretained Class componentClass;
+        Counters counters;
+      };
+      std::unordered_map<ViewKey, Counters> _viewKeys;
+      std::unordered_map<const void *, ComponentClassCounters> _componentClasses;
+    };
+
+    /**
+     An optional process-wide tier behind the per-container pools, so that views created in one container can be
+     reused in another. Views that stay hidden in a container's pool through two consecutive mounts of that container
+     are parked here, and a container that runs out of views for a key takes one from here before creating a new one.
+
+     Disabled until limits are set. Main thread only.
+     */
+    class GlobalViewReusePool {
+    public:
+      static GlobalViewReusePool &sharedPool() noexcept;
+
+      /**
+       Caps the number of parked views for any single key and overall, evicting the least recently parked views beyond
+       either cap. Passing 0 for maxViews disables the pool, releasing all parked views and forgetting recorded demand.
+       */
+      void setLimits(NSUInteger maxViewsPerKey, NSUInteger maxViews) noexcept;
+      bool isEnabled() const noexcept { return _maxViews > 0; }
+
+      /** Removes a hidden view from its container and parks it. */
+      void park(const ViewKey &key, UIView *view) noexcept;
+      /** Removes and returns the most recently parked view for the key, or nil if there is none. */
+      UIView *take(const ViewKey &key) noexcept;
+      /** Releases the least recently parked views until at most maxViews remain, e.g. on memory warnings. */
+      void trim(NSUInteger maxViews) noexcept;
+
+      NSUInteger count() const noexcept { return _entries.size(); }
+
+      /**
+       Records that a container needed `count` views for the key in a single mount. Called by the per-container pools
+       while the global pool is enabled; this is what prewarm() works from.
+       */
+      void recordDemand(const ViewKey &key, const CKComponentViewClass &viewClass, size_t count) noexcept;
+
+      /**
+       Creates views ahead of demand and parks them, until the budget is spent. Keys needed by the most mounts come
+       first; each is filled up to the most views a single container has needed at once, and the pool is never filled
+       beyond its limits.
+       @return Whether there are views left to create.
+       */
+      bool prewarm(CFTimeInterval budget) noexcept;
+
+      /** Prewarms whenever the main run loop is about to go idle in its default mode, until prewarm() runs out of work. */
+      void schedulePrewarming(CFTimeInterval budgetPerTurn) noexcept;
+
+    private:
+      struct Entry {
+        ViewKey key;
+        UIView *view;
+      };
+      /** Least recently parked first. */
+      std::deque<Entry> _entries;
+      NSUInteger _maxViewsPerKey = 0;
+      NSUInteger _maxViews = 0;
+
+      struct Demand {
+        CKComponentViewClass viewClass;
+        /** How many container mounts needed views for the key. */
+        NSUInteger mounts = 0;
+        /** The most views for the key that a single container mount needed. */
+        NSUInteger peak = 0;
+      };
+      std::unordered_map<ViewKey, Demand> _demand;
+      CFRunLoopObserverRef _prewarmingObserver = nullptr;
+    };
+
     class ViewReusePool {
     public:
       ViewReusePool() : position(pool.begin()) {};
@@ -83,8 +210,16 @@ namespace CK {
 
       /** Unhides all views vended so far; hides others. Resets position to begin(). */
       void reset(MountAnalyticsContext *mountAnalyticsContext) noexcept;
+      /**
+       As above; in addition, if the global pool is enabled, parks the views that weren't vended in this pass nor in the
+       previous one there.
+       */
+      void reset(const ViewKey &key, MountAnalyticsContext *mountAnalyticsContext) noexcept;
 
-      UIView *viewForClass(const CKComponentViewClass &viewClass, UIView *container, MountAnalyticsContext *mountAnalyticsContext) noexcept;
+      UIView *viewForClass(const ViewKey &key,
+                           const CKComponentViewClass &viewClass,
+                           UIView *container,
+                           MountAnalyticsContext *mountAnalyticsContext) noexcept;
 
       /** Hide all views in viewpool of `view` and trigger `didHide` of descendant. */
       static void hideAll(UIView *view, MountAnalyticsContext *mountAnalyticsContext) noexcept;
@@ -92,6 +227,10 @@ namespace CK {
       std::vector<UIView *> pool;
       /** Points to the next view in pool that has *not* yet been vended. */
       std::vector<UIView *>::iterator position;
+      /** How many views were vended in the previous pass. */
+      size_t previouslyVendedCount = 0;
+      /** The view class of the views in the pool, recorded along with demand for prewarming. */
+      CKComponentViewClass viewClass;
 
       ViewReusePool(const ViewReusePool&) = delete;
       ViewReusePool &operator=(const ViewReusePool&) = delete;
@@ -120,7 +259,7 @@ namespace CK {
           config.attributeShape(),
         };
         // Note that operator[] creates a new ViewReusePool if one doesn't exist yet. This is what we want.
-        auto const v = dictionary[key].viewForClass(config.viewClass(), container, mountAnalyticsContext);
+        auto const v = dictionary[key].viewForClass(key, config.viewClass(), container, mountAnalyticsContext);
         vendedViews.push_back(v);
         return v;
       }
@@ -134,11 +273,48 @@ namespace CK {
       ViewReusePoolMap &operator=(const ViewReusePoolMap&) = delete;
     };
 
+    /**
+     Attribute diffs computed before mount, usually on the background thread that computed the layout, so that mount
+     only has to replay them. Each diff is keyed by the attributes being mounted and is only used if the view being
+     configured still shows the attributes it was computed against; otherwise attributes are diffed during mount.
+     */
+    class MountPreparation {
+    public:
+      /** Diffs the attributes of `to` against those of `from`, which is expected to be shown by the view `to` gets. */
+      void prepare(const CKViewConfiguration &from, const CKViewConfiguration &to);
+
+      bool empty() const noexcept { return _diffs.empty(); }
+
+    private:
+      friend class AttributeApplicator;
+
+      struct Operation {
+        enum Kind : uint8_t { unapply, apply, update } kind;
+        uint32_t oldIndex;
+        uint32_t newIndex;
+      };
+
+      struct AttributeDiff {
+        std::shared_ptr<const CKViewComponentAttributeValueMap> from;
+        /** Retained so that the map's address can't be reused while it keys `_diffs`. */
+        std::shared_ptr<const CKViewComponentAttributeValueMap> to;
+        std::vector<Operation> operations;
+      };
+
+      std::unordered_map<const CKViewComponentAttributeValueMap *, AttributeDiff> _diffs;
+    };
+
     class AttributeApplicator {
     public:
       static void apply(UIView *view, const CKViewConfiguration &config) noexcept
       {
-        applyAttributes(view, config.attributes());
+        applyAttributes(view, config.attributes(), nullptr);
+      }
+
+      /** Replays the attribute diff prepared for `config`, if it still applies to the view. */
+      static void apply(UIView *view, const CKViewConfiguration &config, const MountPreparation *preparation) noexcept
+      {
+        applyAttributes(view, config.attributes(), preparation);
       }
 
       /** Internal implementation detail of CKPerformOptimisticViewMutation; don't use this directly. */
@@ -151,7 +327,9 @@ namespace CK {
       static void resetOptimisticViewMutations(UIView *view) noexcept;
 
     private:
-      static void applyAttributes(UIView *view, std::shared_ptr<const CKViewComponentAttributeValueMap> attributes) noexcept;
+      static void applyAttributes(UIView *view,
+                                  std::shared_ptr<const CKViewComponentAttributeValueMap> attributes,
+                                  const MountPreparation *preparation) noexcept;
     };
 
     /**
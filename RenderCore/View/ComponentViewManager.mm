@@ -11,13 +11,17 @@
 #include "ComponentViewManager.h"
 
 #import <objc/runtime.h>
+#import <QuartzCore/QuartzCore.h>
+#import <algorithm>
+#import <cmath>
 #import <unordered_map>
 
 #import <RenderCore/RCAssert.h>
 #import <RenderCore/RCAssociatedObject.h>
+#import <RenderCore/RCDeferredRelease.h>
 #import <RenderCore/CKGlobalConfig.h>
-#import <RenderCore/CKMutex.h>
 #import <RenderCore/ComponentViewReuseUtilities.h>
+#import <RenderCore/RCInterningTable.h>
 
 #import "CKMountedObjectForView.h"
 
@@ -25,30 +29,61 @@ using namespace CK::Component;
 
 namespace CK {
   namespace Component {
-    struct PersistentAttributeShapeKey {
-      /** Identifiers in sorted order. For the small sizes we use, this is faster than set or unordered_set. */
-      std::vector<std::string> identifiers;
-      /** Cumulative hash of all identifiers */
-      size_t hash;
-
-      /** Initialize the hash field to 0; remember that C++ doesn't initialize POD fields by default. */
-      PersistentAttributeShapeKey() : hash(0) {};
+    static constexpr uint64_t kPersistentAttributeShapeHashSeed = 0x9e3779b97f4a7c15ULL;
+
+    /**
+     Hashes sets of persistent attributes, either as an attribute map or as the interned identifiers of its persistent
+     attributes. Attribute maps are sorted by interned identifier, so both are hashed in the same order.
+     */
+    struct PersistentAttributeShapeHash {
+      size_t operator()(const std::vector<int32_t> &identifiers) const noexcept
+      {
+        uint64_t hash = kPersistentAttributeShapeHashSeed;
+        for (const auto identifier : identifiers) {
+          hash = RCHashCombine(hash, identifier);
+        }
+        return (size_t)hash;
+      }
 
-      void addString(const std::string &s)
+      size_t operator()(const CKViewComponentAttributeValueMap &attributes) const noexcept
       {
-        identifiers.insert(std::lower_bound(identifiers.begin(), identifiers.end(), s), s);
-        // XOR'ing hashes is often a bad idea. Two of the reasons why are that two identical values will cancel each
-        // other out, and that ordering information is lost (a ^ b == b ^ a). Since we don't expect identical values and
-        // ordering doesn't matter (indeed *must not* matter), go ahead and use XOR here.
-        hash ^= std::hash<std::string>()(s);
+        uint64_t hash = kPersistentAttributeShapeHashSeed;
+        for (const auto &it : attributes) {
+          if (it.first.unapplicator == nil) {
+            hash = RCHashCombine(hash, it.first.internedIdentifier);
+          }
+        }
+        return (size_t)hash;
       }
+    };
 
-      bool operator==(const CK::Component::PersistentAttributeShapeKey &k) const
+    struct PersistentAttributeShapeEqual {
+      bool operator()(const std::vector<int32_t> &identifiers, const CKViewComponentAttributeValueMap &attributes) const noexcept
       {
-        return identifiers == k.identifiers;
+        auto identifier = identifiers.begin();
+        for (const auto &it : attributes) {
+          if (it.first.unapplicator == nil) {
+            if (identifier == identifiers.end() || *identifier != it.first.internedIdentifier) {
+              return false;
+            }
+            identifier++;
+          }
+        }
+        return identifier == identifiers.end();
       }
     };
 
+    static std::vector<int32_t> persistentAttributeIdentifiers(const CKViewComponentAttributeValueMap &attributes) noexcept
+    {
+      std::vector<int32_t> identifiers;
+      for (const auto &it : attributes) {
+        if (it.first.unapplicator == nil) {
+          identifiers.push_back(it.first.internedIdentifier);
+        }
+      }
+      return identifiers;
+    }
+
     struct ActionDisabler {
       ActionDisabler() : _originalValue([CATransaction disableActions]) { [CATransaction setDisableActions:YES]; }
       ~ActionDisabler() { [CATransaction setDisableActions:_originalValue]; }
@@ -58,36 +93,11 @@ namespace CK {
   }
 }
 
-namespace std {
-  template <> struct hash<const CK::Component::PersistentAttributeShapeKey>
-  {
-    size_t operator()(const CK::Component::PersistentAttributeShapeKey &k) const { return k.hash; }
-  };
-}
-
 int32_t PersistentAttributeShape::computeIdentifier(const CKViewComponentAttributeValueMap &attributes) noexcept
 {
-  CK::Component::PersistentAttributeShapeKey key;
-  for (const auto &it : attributes) {
-    if (it.first.unapplicator == nil) {
-      key.addString(it.first.identifier);
-    }
-  }
-
-  static CK::StaticMutex lock = CK_MUTEX_INITIALIZER; // protects identifierMap
-  CK::StaticMutexLocker l(lock);
-  static auto *identifierMap = new std::unordered_map<const CK::Component::PersistentAttributeShapeKey, const int32_t>();
-
-  static int32_t nextIdentifier = 0;
-  const auto it = identifierMap->find(key);
-  if (it == identifierMap->end()) {
-    // We don't need fancy atomic here because we're already under the StaticMutex (for identifierMap).
-    int32_t identifier = nextIdentifier++;
-    identifierMap->emplace(std::move(key), identifier);
-    return identifier;
-  } else {
-    return it->second;
-  }
+  static auto *interner =
+  new CK::InterningTable<std::vector<int32_t>, PersistentAttributeShapeHash, PersistentAttributeShapeEqual>(256);
+  return interner->intern(attributes, [&]{ return persistentAttributeIdentifiers(attributes); });
 }
 
 @interface CKOptimisticViewMutationTokenWrapper : NSObject
@@ -116,14 +126,262 @@ int32_t PersistentAttributeShape::computeIdentifier(const CKViewComponentAttribu
 }
 @end
 
-UIView *ViewReusePool::viewForClass(const CKComponentViewClass &viewClass, UIView *container, CK::Component::MountAnalyticsContext *mountAnalyticsContext) noexcept
+void MountTrace::record(const ViewKey &key, Event event, CFTimeInterval duration) noexcept
+{
+  auto &counter = _viewKeys[key][event];
+  counter.count++;
+  counter.duration += duration;
+  record(key.componentClass, event, duration);
+}
+
+void MountTrace::record(Class componentClass, Event event, CFTimeInterval duration) noexcept
+{
+  auto &entry = _componentClasses[(__bridge const void *)componentClass];
+  entry.componentClass = componentClass;
+  entry.counters[event].count++;
+  entry.counters[event].duration += duration;
+}
+
+auto MountTrace::countersForViewKey(const ViewKey &key) const noexcept -> const Counters *
+{
+  const auto it = _viewKeys.find(key);
+  return it != _viewKeys.end() ? &it->second : nullptr;
+}
+
+auto MountTrace::countersForComponentClass(Class componentClass) const noexcept -> const Counters *
+{
+  const auto it = _componentClasses.find((__bridge const void *)componentClass);
+  return it != _componentClasses.end() ? &it->second.counters : nullptr;
+}
+
+static NSDictionary *traceEvents(const MountTrace::Counters &counters)
+{
+  static NSString *const eventNames[] = {@"viewCreation", @"attributeApplication", @"willMount", @"didMount"};
+  static_assert(sizeof(eventNames) / sizeof(eventNames[0]) == MountTrace::eventCount, "Every event needs a name");
+  NSMutableDictionary *const events = [NSMutableDictionary dictionary];
+  for (size_t i = 0; i < counters.size(); i++) {
+    if (counters[i].count > 0) {
+      events[eventNames[i]] = @[@(counters[i].count), @((long long)llround(counters[i].duration * 1e6))];
+    }
+  }
+  return events;
+}
+
+NSData *MountTrace::JSONData() const
+{
+  NSMutableArray *const viewKeys = [NSMutableArray arrayWithCapacity:_viewKeys.size()];
+  for (const auto &it : _viewKeys) {
+    [viewKeys addObject:@{
+      @"componentClass": NSStringFromClass(it.first.componentClass) ?: @"",
+      @"viewClass": [NSString stringWithUTF8String:it.first.viewClassIdentifier.description().c_str()] ?: @"",
+      @"attributeShape": @(std::hash<PersistentAttributeShape>()(it.first.attributeShape)),
+      @"events": traceEvents(it.second),
+    }];
+  }
+  NSMutableArray *const componentClasses = [NSMutableArray arrayWithCapacity:_componentClasses.size()];
+  for (const auto &it : _componentClasses) {
+    [componentClasses addObject:@{
+      @"componentClass": NSStringFromClass(it.second.componentClass) ?: @"",
+      @"events": traceEvents(it.second.counters),
+    }];
+  }
+  return [NSJSONSerialization dataWithJSONObject:@{@"viewKeys": viewKeys, @"componentClasses": componentClasses}
+                                         options:0
+                                           error:nil];
+}
+
+GlobalViewReusePool &GlobalViewReusePool::sharedPool() noexcept
+{
+  static GlobalViewReusePool *pool;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    pool = new GlobalViewReusePool();
+    [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationDidReceiveMemoryWarningNotification
+                                                      object:nil
+                                                       queue:[NSOperationQueue mainQueue]
+                                                  usingBlock:^(NSNotification *note) {
+                                                    pool->trim(0);
+                                                  }];
+  });
+  return *pool;
+}
+
+void GlobalViewReusePool::setLimits(NSUInteger maxViewsPerKey, NSUInteger maxViews) noexcept
+{
+  RCCAssertMainThread();
+  _maxViewsPerKey = maxViewsPerKey;
+  _maxViews = maxViews;
+  trim(maxViews);
+  if (maxViews == 0) {
+    _demand.clear();
+  }
+  // Enforce the new per-key cap, newest views first so that the oldest are evicted.
+  std::deque<Entry> kept;
+  for (auto it = _entries.rbegin(); it != _entries.rend(); ++it) {
+    const auto keyCount = std::count_if(kept.begin(), kept.end(), [&](const Entry &e){ return e.key == it->key; });
+    if ((NSUInteger)keyCount < maxViewsPerKey) {
+      kept.push_front(std::move(*it));
+    } else {
+      RCDeferRelease(it->view);
+    }
+  }
+  _entries = std::move(kept);
+}
+
+void GlobalViewReusePool::park(const ViewKey &key, UIView *view) noexcept
+{
+  RCCAssertMainThread();
+  RCCAssert(view.hidden, @"Only hidden views may be parked, got %@", view);
+  if (view.superview != nil) {
+    ViewReuseUtilities::willRemoveFromParent(view, view.superview);
+    [view removeFromSuperview];
+  }
+  if (_maxViewsPerKey == 0) {
+    RCDeferRelease(view);
+    return;
+  }
+  // Parked views are few, so a linear scan for the oldest view with the same key is cheap next to creating views.
+  NSUInteger keyCount = 0;
+  auto oldestWithKey = _entries.end();
+  for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+    if (it->key == key) {
+      if (keyCount++ == 0) {
+        oldestWithKey = it;
+      }
+    }
+  }
+  if (keyCount >= _maxViewsPerKey) {
+    RCDeferRelease(oldestWithKey->view);
+    _entries.erase(oldestWithKey);
+  }
+  _entries.push_back({key, view});
+  trim(_maxViews);
+}
+
+UIView *GlobalViewReusePool::take(const ViewKey &key) noexcept
+{
+  RCCAssertMainThread();
+  for (auto it = _entries.rbegin(); it != _entries.rend(); ++it) {
+    if (it->key == key) {
+      UIView *const view = it->view;
+      _entries.erase(std::next(it).base());
+      return view;
+    }
+  }
+  return nil;
+}
+
+void GlobalViewReusePool::trim(NSUInteger maxViews) noexcept
+{
+  RCCAssertMainThread();
+  // Evicted views are released along with everything else the current mount or frame drops.
+  while (_entries.size() > maxViews) {
+    RCDeferRelease(_entries.front().view);
+    _entries.pop_front();
+  }
+}
+
+void GlobalViewReusePool::recordDemand(const ViewKey &key, const CKComponentViewClass &viewClass, size_t count) noexcept
+{
+  auto &demand = _demand[key];
+  if (demand.mounts++ == 0) {
+    demand.viewClass = viewClass;
+  }
+  demand.peak = std::max<NSUInteger>(demand.peak, count);
+}
+
+bool GlobalViewReusePool::prewarm(CFTimeInterval budget) noexcept
+{
+  RCCAssertMainThread();
+  if (!isEnabled()) {
+    return false;
+  }
+  const auto start = CACurrentMediaTime();
+  std::vector<std::pair<const ViewKey *, const Demand *>> ranked;
+  ranked.reserve(_demand.size());
+  for (const auto &it : _demand) {
+    ranked.push_back({&it.first, &it.second});
+  }
+  std::sort(ranked.begin(), ranked.end(), [](const auto &lhs, const auto &rhs){
+    return lhs.second->mounts > rhs.second->mounts;
+  });
+
+  for (const auto &it : ranked) {
+    const auto &key = *it.first;
+    const auto &demand = *it.second;
+    const auto target = std::min(demand.peak, _maxViewsPerKey);
+    auto parked = (NSUInteger)std::count_if(_entries.begin(), _entries.end(), [&](const Entry &e){ return e.key == key; });
+    while (parked < target) {
+      if (_entries.size() >= _maxViews) {
+        return false;
+      }
+      if (CACurrentMediaTime() - start >= budget) {
+        return true;
+      }
+      UIView *const view = demand.viewClass.createView();
+      RCCAssertNotNil(view, @"Expected non-nil view to be created for view class %s", demand.viewClass.getIdentifier().description().c_str());
+      [view setHidden:YES];
+      ViewReuseUtilities::createdHiddenView(view, demand.viewClass);
+      _entries.push_back({key, view});
+      parked++;
+    }
+  }
+  return false;
+}
+
+void GlobalViewReusePool::schedulePrewarming(CFTimeInterval budgetPerTurn) noexcept
+{
+  RCCAssertMainThread();
+  if (_prewarmingObserver != nullptr) {
+    return;
+  }
+  _prewarmingObserver =
+  CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting, true, 0, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+    if (!prewarm(budgetPerTurn)) {
+      CFRunLoopObserverInvalidate(observer);
+      CFRelease(observer);
+      _prewarmingObserver = nullptr;
+    }
+  });
+  // Only the default mode, so that prewarming doesn't compete with scrolling.
+  CFRunLoopAddObserver(CFRunLoopGetMain(), _prewarmingObserver, kCFRunLoopDefaultMode);
+}
+
+UIView *ViewReusePool::viewForClass(const ViewKey &key,
+                                    const CKComponentViewClass &viewClass,
+                                    UIView *container,
+                                    CK::Component::MountAnalyticsContext *mountAnalyticsContext) noexcept
 {
   if (position == pool.end()) {
+    auto &globalPool = GlobalViewReusePool::sharedPool();
+    if (globalPool.isEnabled()) {
+      if (UIView *v = globalPool.take(key)) {
+        [container addSubview:v];
+        ViewReuseUtilities::didAddToParent(v, container);
+        pool.push_back(v);
+        position = pool.end();
+        this->viewClass = viewClass;
+        if (auto mac = mountAnalyticsContext) {
+          mac->viewReuses++;
+          mac->globalViewReuses++;
+        }
+        return v;
+      }
+      if (auto mac = mountAnalyticsContext) {
+        mac->globalViewReuseMisses++;
+      }
+    }
+    const auto trace = mountAnalyticsContext ? mountAnalyticsContext->trace.get() : nullptr;
+    const auto start = trace ? CACurrentMediaTime() : 0;
     UIView *v = viewClass.createView();
+    if (trace) {
+      trace->record(key, MountTrace::viewCreation, CACurrentMediaTime() - start);
+    }
     RCCAssertNotNil(v, @"Expected non-nil view to be created for view class %s", viewClass.getIdentifier().description().c_str());
     [container addSubview:v];
     pool.push_back(v);
     position = pool.end();
+    this->viewClass = viewClass;
     ViewReuseUtilities::createdView(v, viewClass, container);
     if (auto mac = mountAnalyticsContext) {
       mac->viewAllocations++;
@@ -151,6 +409,29 @@ void ViewReusePool::reset(CK::Component::MountAnalyticsContext *mountAnalyticsCo
   position = pool.begin();
 }
 
+void ViewReusePool::reset(const ViewKey &key, CK::Component::MountAnalyticsContext *mountAnalyticsContext) noexcept
+{
+  const size_t vendedCount = position - pool.begin();
+  reset(mountAnalyticsContext);
+  auto &globalPool = GlobalViewReusePool::sharedPool();
+  const auto idleFrom = std::max(vendedCount, previouslyVendedCount);
+  previouslyVendedCount = vendedCount;
+  if (!globalPool.isEnabled()) {
+    return;
+  }
+  if (vendedCount > 0) {
+    globalPool.recordDemand(key, viewClass, vendedCount);
+  }
+  if (idleFrom >= pool.size()) {
+    return;
+  }
+  for (auto it = pool.begin() + idleFrom; it != pool.end(); ++it) {
+    globalPool.park(key, *it);
+  }
+  pool.erase(pool.begin() + idleFrom, pool.end());
+  position = pool.begin();
+}
+
 const char kComponentViewReusePoolMapAssociatedObjectKey = ' ';
 
 void ViewReusePool::hideAll(UIView *view, MountAnalyticsContext *mountAnalyticsContext) noexcept
@@ -185,7 +466,7 @@ ViewReusePoolMap &ViewReusePoolMap::viewReusePoolMapForView(UIView *v) noexcept
 void ViewReusePoolMap::reset(UIView *container, CK::Component::MountAnalyticsContext *mountAnalyticsContext) noexcept
 {
   for (auto &it : dictionary) {
-    it.second.reset(mountAnalyticsContext);
+    it.second.reset(it.first, mountAnalyticsContext);
   }
 
   // Now we need to ensure that the ordering of container.subviews matches vendedViews.
@@ -243,7 +524,85 @@ static CKComponentAttributeSetWrapper *attributeSetWrapperForView(UIView *view)
   return wrapper;
 }
 
-void AttributeApplicator::applyAttributes(UIView *view, std::shared_ptr<const CKViewComponentAttributeValueMap> attributes) noexcept
+/**
+ Diffs two attribute maps, calling `unapply` for each old attribute that must be torn down and then `apply` or `update`
+ for each new attribute that must be (re)applied. Both maps are sorted by interned attribute identifier, so each pass is
+ a linear merge rather than a lookup per attribute.
+ */
+template <typename Unapply, typename Apply, typename Update>
+static void diffAttributes(const CKViewComponentAttributeValueMap &oldAttributes,
+                           const CKViewComponentAttributeValueMap &newAttributes,
+                           const Unapply &unapply,
+                           const Apply &apply,
+                           const Update &update)
+{
+  // First, tear down any attributes that appear in the *old* set but not the new set, and *do* have an unapplicator.
+  auto newIt = newAttributes.begin();
+  for (auto oldIt = oldAttributes.begin(); oldIt != oldAttributes.end(); ++oldIt) {
+    while (newIt != newAttributes.end() && newIt->first < oldIt->first) {
+      ++newIt;
+    }
+    if (oldIt->first.unapplicator) {
+      if (newIt == newAttributes.end() || !(newIt->first == oldIt->first)) {
+        // There is no new attribute, so we always must call "unapplicator".
+        unapply(oldIt);
+      } else if (!RCObjectIsEqual(newIt->second, oldIt->second)) {
+        // If the attribute has an updater, don't call the unapplicator; instead, the updater will be called below.
+        if (newIt->first.updater == nil) {
+          unapply(oldIt);
+        }
+      }
+    }
+  }
+
+  // Now apply the applicators for all attributes in the *new* set, except those that haven't changed in value.
+  auto oldIt = oldAttributes.begin();
+  for (auto newIt = newAttributes.begin(); newIt != newAttributes.end(); ++newIt) {
+    while (oldIt != oldAttributes.end() && oldIt->first < newIt->first) {
+      ++oldIt;
+    }
+    if (oldIt == oldAttributes.end() || !(oldIt->first == newIt->first)) {
+      // There is no old attribute, so we always must call "applicator".
+      apply(newIt);
+    } else if (!RCObjectIsEqual(oldIt->second, newIt->second)) {
+      // If the attribute has an "updater", call that. Otherwise, call the applicator.
+      if (newIt->first.updater) {
+        update(oldIt, newIt);
+      } else {
+        apply(newIt);
+      }
+    }
+  }
+}
+
+void MountPreparation::prepare(const CKViewConfiguration &from, const CKViewConfiguration &to)
+{
+  const auto &fromAttributes = from.attributes();
+  const auto &toAttributes = to.attributes();
+  if (fromAttributes == nullptr || toAttributes == nullptr || fromAttributes == toAttributes) {
+    return;
+  }
+  auto &diff = _diffs[toAttributes.get()];
+  if (diff.to != nullptr) {
+    return; // These attributes are mounted in more than one place; keep the first diff.
+  }
+  diff.from = fromAttributes;
+  diff.to = toAttributes;
+
+  const auto oldBegin = fromAttributes->begin();
+  const auto newBegin = toAttributes->begin();
+  diffAttributes(*fromAttributes, *toAttributes, [&](auto oldIt){
+    diff.operations.push_back({Operation::unapply, (uint32_t)(oldIt - oldBegin), 0});
+  }, [&](auto newIt){
+    diff.operations.push_back({Operation::apply, 0, (uint32_t)(newIt - newBegin)});
+  }, [&](auto oldIt, auto newIt){
+    diff.operations.push_back({Operation::update, (uint32_t)(oldIt - oldBegin), (uint32_t)(newIt - newBegin)});
+  });
+}
+
+void AttributeApplicator::applyAttributes(UIView *view,
+                                          std::shared_ptr<const CKViewComponentAttributeValueMap> attributes,
+                                          const MountPreparation *preparation) noexcept
 {
   CK::Component::ActionDisabler actionDisabler; // We never want implicit animations when applying attributes
 
@@ -277,36 +636,41 @@ void AttributeApplicator::applyAttributes(UIView *view, std::shared_ptr<const CK
   const CKViewComponentAttributeValueMap &oldAttributes = wrapper->_attributes ? *wrapper->_attributes : *empty;
   const CKViewComponentAttributeValueMap &newAttributes = *attributes;
 
-  // First, tear down any attributes that appear in the *old* set but not the new set, and *do* have an unapplicator.
-  for (const auto &oldAttr : oldAttributes) {
-    if (oldAttr.first.unapplicator) {
-      const auto &newAttr = newAttributes.find(oldAttr.first);
-      if (newAttr == newAttributes.end()) {
-        // There is no new attribute, so we always must call "unapplicator".
-        oldAttr.first.unapplicator(view, oldAttr.second);
-      } else if (!RCObjectIsEqual(newAttr->second, oldAttr.second)) {
-        // If the attribute has an updater, don't call the unapplicator; instead, the updater will be called below.
-        if (newAttr->first.updater == nil) {
-          oldAttr.first.unapplicator(view, oldAttr.second);
-        }
-      }
+  const auto preparedDiff = [&]() -> const MountPreparation::AttributeDiff * {
+    if (preparation == nullptr) {
+      return nullptr;
     }
-  }
-
-  // Now apply the applicators for all attributes in the *new* set, except those that haven't changed in value.
-  for (const auto &newAttr : newAttributes) {
-    const auto &oldAttr = oldAttributes.find(newAttr.first);
-    if (oldAttr == oldAttributes.end()) {
-      // There is no old attribute, so we always must call "applicator".
-      newAttr.first.applicator(view, newAttr.second);
-    } else if (!RCObjectIsEqual(oldAttr->second, newAttr.second)) {
-      // If the attribute has an "updater", call that. Otherwise, call the applicator.
-      if (newAttr.first.updater) {
-        newAttr.first.updater(view, oldAttr->second, newAttr.second);
-      } else {
-        newAttr.first.applicator(view, newAttr.second);
+    const auto it = preparation->_diffs.find(attributes.get());
+    return it != preparation->_diffs.end() && it->second.from == wrapper->_attributes ? &it->second : nullptr;
+  }();
+
+  if (preparedDiff) {
+    // The view still shows the attributes the diff was prepared against, so only its operations need replaying.
+    const auto oldBegin = oldAttributes.begin();
+    const auto newBegin = newAttributes.begin();
+    for (const auto &operation : preparedDiff->operations) {
+      switch (operation.kind) {
+        case MountPreparation::Operation::unapply:
+          oldBegin[operation.oldIndex].first.unapplicator(view, oldBegin[operation.oldIndex].second);
+          break;
+        case MountPreparation::Operation::apply:
+          newBegin[operation.newIndex].first.applicator(view, newBegin[operation.newIndex].second);
+          break;
+        case MountPreparation::Operation::update:
+          newBegin[operation.newIndex].first.updater(view,
+                                                     oldBegin[operation.oldIndex].second,
+                                                     newBegin[operation.newIndex].second);
+          break;
       }
     }
+  } else {
+    diffAttributes(oldAttributes, newAttributes, [&](auto oldIt){
+      oldIt->first.unapplicator(view, oldIt->second);
+    }, [&](auto newIt){
+      newIt->first.applicator(view, newIt->second);
+    }, [&](auto oldIt, auto newIt){
+      newIt->first.updater(view, oldIt->second, newIt->second);
+    });
   }
 
   if (hasNewStyleOptimisticViewMutations) {
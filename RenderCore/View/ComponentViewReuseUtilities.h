@@ -12,6 +12,7 @@
 
 #if CK_NOT_SWIFT
 
+#import <memory>
 #import <vector>
 
 #import <UIKit/UIKit.h>
@@ -20,12 +21,20 @@ struct CKComponentViewClass;
 
 namespace CK {
   namespace Component {
+    class MountTrace;
+
     /** Will be used to collect information during mount. */
     struct MountAnalyticsContext {
       NSUInteger viewAllocations = 0;
       NSUInteger viewReuses = 0;
       NSUInteger viewHides = 0;
       NSUInteger viewUnhides = 0;
+      /** Views taken from the global reuse pool, which are also counted as reuses. */
+      NSUInteger globalViewReuses = 0;
+      /** Views that had to be created because the global reuse pool had none for their key. */
+      NSUInteger globalViewReuseMisses = 0;
+      /** If non-null, mount records per ViewKey and per component class timings into it. */
+      std::shared_ptr<MountTrace> trace;
     };
 
     class ViewReuseUtilities {
@@ -34,8 +43,14 @@ namespace CK {
       static void mountingInRootView(UIView *rootView) noexcept;
       /** Called when Components creates a view */
       static void createdView(UIView *view, const CKComponentViewClass &viewClass, UIView *parent) noexcept;
+      /** Called when Components creates a hidden view ahead of time, without a parent until it is first used */
+      static void createdHiddenView(UIView *view, const CKComponentViewClass &viewClass) noexcept;
       /** Called when Components will begin mounting child components in a new child view */
       static void mountingInChildContext(UIView *view, UIView *parent) noexcept;
+      /** Called when Components is about to move a hidden Components-managed view out of its parent */
+      static void willRemoveFromParent(UIView *view, UIView *parent) noexcept;
+      /** Called when Components has added a Components-managed view that was moved out of another parent */
+      static void didAddToParent(UIView *view, UIView *parent) noexcept;
 
       /** Called when Components is about to hide a Components-managed view */
       static void didHide(UIView *view, MountAnalyticsContext *mountAnalyticsContext) noexcept;
@@ -27,6 +27,8 @@ static char const kViewReuseInfoKey = ' ';
       didEnterReusePoolBlock:(void (^)(UIView *))didEnterReusePoolBlock
      willLeaveReusePoolBlock:(void (^)(UIView *))willLeaveReusePoolBlock;
 - (void)registerChildViewInfo:(CKComponentViewReuseInfo *)info;
+- (void)unregisterChildViewInfo:(CKComponentViewReuseInfo *)info;
+- (void)didMoveToParentInfo:(CKComponentViewReuseInfo *)parentInfo;
 - (void)didHide:(CK::Component::MountAnalyticsContext *)mountAnalyticsContext;
 - (void)willUnhide:(CK::Component::MountAnalyticsContext *)mountAnalyticsContext;
 - (void)ancestorDidHide;
@@ -61,6 +63,18 @@ void ViewReuseUtilities::createdView(UIView *view, const CKComponentViewClass &v
   [parentInfo registerChildViewInfo:info];
 }
 
+void ViewReuseUtilities::createdHiddenView(UIView *view, const CKComponentViewClass &viewClass) noexcept
+{
+  RCCAssertNil(RCGetAssociatedObject_MainThreadAffined(view, &kViewReuseInfoKey),
+               @"Didn't expect reuse info on just-created view %@", view);
+
+  CKComponentViewReuseInfo *info = [[CKComponentViewReuseInfo alloc] initWithView:view
+                                                           didEnterReusePoolBlock:viewClass.didEnterReusePool
+                                                          willLeaveReusePoolBlock:viewClass.willLeaveReusePool];
+  RCSetAssociatedObject_MainThreadAffined(view, &kViewReuseInfoKey, info);
+  [info didHide:nullptr];
+}
+
 void ViewReuseUtilities::mountingInChildContext(UIView *view, UIView *parent) noexcept
 {
   // If this view was created by the components infrastructure, or if we've
@@ -79,6 +93,24 @@ void ViewReuseUtilities::mountingInChildContext(UIView *view, UIView *parent) no
   [parentInfo registerChildViewInfo:info];
 }
 
+void ViewReuseUtilities::willRemoveFromParent(UIView *view, UIView *parent) noexcept
+{
+  CKComponentViewReuseInfo *info = RCGetAssociatedObject_MainThreadAffined(view, &kViewReuseInfoKey);
+  RCCAssertNotNil(info, @"Expect to find reuse info on all components-managed views but found none on %@", view);
+  CKComponentViewReuseInfo *parentInfo = RCGetAssociatedObject_MainThreadAffined(parent, &kViewReuseInfoKey);
+  [parentInfo unregisterChildViewInfo:info];
+}
+
+void ViewReuseUtilities::didAddToParent(UIView *view, UIView *parent) noexcept
+{
+  CKComponentViewReuseInfo *info = RCGetAssociatedObject_MainThreadAffined(view, &kViewReuseInfoKey);
+  RCCAssertNotNil(info, @"Expect to find reuse info on all components-managed views but found none on %@", view);
+  CKComponentViewReuseInfo *parentInfo = RCGetAssociatedObject_MainThreadAffined(parent, &kViewReuseInfoKey);
+  RCCAssertNotNil(parentInfo, @"Expected parentInfo but found none on %@", parent);
+  [parentInfo registerChildViewInfo:info];
+  [info didMoveToParentInfo:parentInfo];
+}
+
 void ViewReuseUtilities::didHide(UIView *view, CK::Component::MountAnalyticsContext *mountAnalyticsContext) noexcept
 {
   CKComponentViewReuseInfo *info = RCGetAssociatedObject_MainThreadAffined(view, &kViewReuseInfoKey);
@@ -124,6 +156,18 @@ void ViewReuseUtilities::willUnhide(UIView *view, CK::Component::MountAnalyticsC
   [_childViewInfos addObject:info];
 }
 
+- (void)unregisterChildViewInfo:(CKComponentViewReuseInfo *)info
+{
+  [_childViewInfos removeObjectIdenticalTo:info];
+}
+
+- (void)didMoveToParentInfo:(CKComponentViewReuseInfo *)parentInfo
+{
+  // Only hidden views are moved, so neither this view nor its descendants change visibility and no blocks are called.
+  RCAssert(_hidden, @"Expected %@ to be hidden while it is moved", _view);
+  _ancestorHidden = parentInfo->_hidden || parentInfo->_ancestorHidden;
+}
+
 - (void)didHide:(CK::Component::MountAnalyticsContext *)mountAnalyticsContext
 {
   if (_hidden) {